@@ -319,10 +319,10 @@ AttackPossibility AttackPossibility::evaluate(
 {
 	auto attacker = attackInfo.attacker;
 	auto defender = attackInfo.defender;
-	const std::string cachingStringBlocksRetaliation = "type_BLOCKS_RETALIATION";
+	static const auto cachingKeyBlocksRetaliation = BonusCacheKey::type(BonusType::BLOCKS_RETALIATION);
 	static const auto selectorBlocksRetaliation = Selector::type()(BonusType::BLOCKS_RETALIATION);
 	const auto attackerSide = state->playerToSide(state->battleGetOwner(attacker));
-	const bool counterAttacksBlocked = attacker->hasBonus(selectorBlocksRetaliation, cachingStringBlocksRetaliation);
+	const bool counterAttacksBlocked = attacker->hasBonus(selectorBlocksRetaliation, cachingKeyBlocksRetaliation);
 
 	AttackPossibility bestAp(hex, BattleHex::INVALID, attackInfo);
 
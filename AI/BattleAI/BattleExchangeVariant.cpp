@@ -131,9 +131,9 @@ float BattleExchangeVariant::trackAttack(
 	std::shared_ptr<HypotheticBattle> hb,
 	bool evaluateOnly)
 {
-	const std::string cachingStringBlocksRetaliation = "type_BLOCKS_RETALIATION";
+	static const auto cachingKeyBlocksRetaliation = BonusCacheKey::type(BonusType::BLOCKS_RETALIATION);
 	static const auto selectorBlocksRetaliation = Selector::type()(BonusType::BLOCKS_RETALIATION);
-	const bool counterAttacksBlocked = attacker->hasBonus(selectorBlocksRetaliation, cachingStringBlocksRetaliation);
+	const bool counterAttacksBlocked = attacker->hasBonus(selectorBlocksRetaliation, cachingKeyBlocksRetaliation);
 
 	int64_t attackDamage = damageCache.getDamage(attacker.get(), defender.get(), hb);
 	float defenderDamageReduce = AttackPossibility::calculateDamageReduce(attacker.get(), defender.get(), attackDamage, damageCache, hb);
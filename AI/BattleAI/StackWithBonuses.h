@@ -91,7 +91,7 @@ public:
 
 	///IBonusBearer
 	TConstBonusListPtr getAllBonuses(const CSelector & selector, const CSelector & limit,
-		const std::string & cachingStr = "") const override;
+		const BonusCacheKey & cachingKey = {}) const override;
 
 	int64_t getTreeVersion() const override;
 
@@ -54,13 +54,13 @@ armyStructure evaluateArmyStructure(const CArmedInstance * army)
 	ui32 maxSpeed = 0;
 
 	static const CSelector selectorSHOOTER = Selector::type()(BonusType::SHOOTER);
-	static const std::string keySHOOTER = "type_"+std::to_string((int32_t)BonusType::SHOOTER);
+	static const auto keySHOOTER = BonusCacheKey::type(BonusType::SHOOTER);
 
 	static const CSelector selectorFLYING = Selector::type()(BonusType::FLYING);
-	static const std::string keyFLYING = "type_"+std::to_string((int32_t)BonusType::FLYING);
+	static const auto keyFLYING = BonusCacheKey::type(BonusType::FLYING);
 
 	static const CSelector selectorSTACKS_SPEED = Selector::type()(BonusType::STACKS_SPEED);
-	static const std::string keySTACKS_SPEED = "type_"+std::to_string((int32_t)BonusType::STACKS_SPEED);
+	static const auto keySTACKS_SPEED = BonusCacheKey::type(BonusType::STACKS_SPEED);
 
 	for(auto s : army->Slots())
 	{
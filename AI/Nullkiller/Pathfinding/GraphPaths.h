@@ -12,6 +12,8 @@
 
 #include "ObjectGraph.h"
 
+#include <boost/heap/fibonacci_heap.hpp>
+
 namespace NKAI
 {
 
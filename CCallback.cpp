@@ -389,6 +389,11 @@ std::shared_ptr<const CPathsInfo> CCallback::getPathsInfo(const CGHeroInstance *
 	return cl->getPathsInfo(h);
 }
 
+std::vector<std::shared_ptr<const CPathsInfo>> CCallback::getPathsInfo(const std::vector<const CGHeroInstance *> & heroes)
+{
+	return cl->getPathsInfo(heroes);
+}
+
 std::optional<PlayerColor> CCallback::getPlayerID() const
 {
 	return CBattleCallback::getPlayerID();
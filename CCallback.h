@@ -158,6 +158,8 @@ public:
 	virtual bool canMoveBetween(const int3 &a, const int3 &b);
 	virtual int3 getGuardingCreaturePosition(int3 tile);
 	virtual std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
+	/// Returns paths of multiple heroes, heroes with outdated paths are processed in parallel
+	virtual std::vector<std::shared_ptr<const CPathsInfo>> getPathsInfo(const std::vector<const CGHeroInstance *> & heroes);
 
 	std::optional<PlayerColor> getPlayerID() const override;
 
@@ -0,0 +1,76 @@
+/*
+ * BenchmarkHarness.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BenchmarkHarness.h"
+
+namespace Benchmark
+{
+
+State::State(int64_t size, Clock::duration minTime)
+	: size(size)
+	, minTime(minTime)
+{
+}
+
+bool State::keepRunning()
+{
+	if(running)
+	{
+		++iterations;
+
+		// checking clock is cheap compared to measured code, but not free - only do it for every 2^n iteration
+		if((iterations & (iterations - 1)) != 0 && iterations > 16)
+			return true;
+
+		elapsed += Clock::now() - started;
+		if(elapsed >= minTime)
+		{
+			running = false;
+			return false;
+		}
+	}
+
+	running = true;
+	started = Clock::now();
+	return true;
+}
+
+void State::pauseTiming()
+{
+	assert(running);
+	elapsed += Clock::now() - started;
+}
+
+void State::resumeTiming()
+{
+	assert(running);
+	started = Clock::now();
+}
+
+double State::getNanosecondsPerIteration() const
+{
+	if(iterations == 0)
+		return 0;
+
+	return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+std::vector<BenchmarkCase> & getRegisteredBenchmarks()
+{
+	static std::vector<BenchmarkCase> benchmarks;
+	return benchmarks;
+}
+
+Registration::Registration(const std::string & name, const BenchmarkFunction & function, const std::vector<int64_t> & sizes)
+{
+	getRegisteredBenchmarks().push_back({name, function, sizes});
+}
+
+}
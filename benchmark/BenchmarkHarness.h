@@ -0,0 +1,82 @@
+/*
+ * BenchmarkHarness.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include <chrono>
+
+namespace Benchmark
+{
+
+/// Passed to benchmark function, controls how many times measured code is executed
+class State
+{
+	using Clock = std::chrono::steady_clock;
+
+	const int64_t size;
+	const Clock::duration minTime;
+
+	int64_t iterations = 0;
+	Clock::duration elapsed = Clock::duration::zero();
+	Clock::time_point started;
+	bool running = false;
+
+public:
+	State(int64_t size, Clock::duration minTime);
+
+	/// Size of synthetic data set requested for this run
+	int64_t getSize() const { return size; }
+
+	/// Returns true while measured code should be executed once more
+	/// Usage: while(state.keepRunning()) { measured code }
+	bool keepRunning();
+
+	/// Excludes code between pauseTiming and resumeTiming (e.g. per-iteration setup) from measurement
+	void pauseTiming();
+	void resumeTiming();
+
+	int64_t getIterations() const { return iterations; }
+	double getNanosecondsPerIteration() const;
+};
+
+using BenchmarkFunction = std::function<void(State &)>;
+
+struct BenchmarkCase
+{
+	std::string name;
+	BenchmarkFunction function;
+	std::vector<int64_t> sizes;
+};
+
+/// Static registration helper, use via VCMI_BENCHMARK macro
+class Registration
+{
+public:
+	Registration(const std::string & name, const BenchmarkFunction & function, const std::vector<int64_t> & sizes);
+};
+
+std::vector<BenchmarkCase> & getRegisteredBenchmarks();
+
+/// Prevents compiler from optimizing away computation of value
+template<typename T>
+inline void doNotOptimize(const T & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void * sink;
+	sink = &value;
+#endif
+}
+
+}
+
+/// Registers benchmark function that will be run once for every of listed data set sizes
+#define VCMI_BENCHMARK(function, ...) \
+	static const Benchmark::Registration function##Registration(#function, function, {__VA_ARGS__})
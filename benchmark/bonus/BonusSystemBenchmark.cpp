@@ -0,0 +1,256 @@
+/*
+ * BonusSystemBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "../BenchmarkHarness.h"
+
+#include "../../lib/bonuses/BonusList.h"
+#include "../../lib/bonuses/BonusSelector.h"
+#include "../../lib/bonuses/CBonusSystemNode.h"
+#include "../../lib/bonuses/Limiters.h"
+#include "../../lib/bonuses/Propagators.h"
+#include "../../lib/bonuses/Updaters.h"
+
+namespace
+{
+
+class BenchmarkNode : public CBonusSystemNode
+{
+	PlayerColor owner;
+public:
+	BenchmarkNode(ENodeTypes type, PlayerColor owner)
+		: CBonusSystemNode(type)
+		, owner(owner)
+	{}
+
+	PlayerColor getOwner() const override
+	{
+		return owner;
+	}
+};
+
+/// Bonus tree that mimics layout of adventure map: global effects -> players -> heroes -> stacks,
+/// with artifacts attached to heroes as bonus sources
+class SyntheticWorld
+{
+	static constexpr int PLAYERS = 8;
+	static constexpr int ARTIFACTS_PER_HERO = 10;
+	static constexpr int STACKS_PER_HERO = 7;
+
+	static std::shared_ptr<Bonus> makeBonus(BonusType type, BonusSource source, int value, BonusSubtypeID subtype = {})
+	{
+		return std::make_shared<Bonus>(BonusDuration::PERMANENT, type, source, value, BonusSourceID(), subtype);
+	}
+
+public:
+	std::unique_ptr<BenchmarkNode> globalEffects;
+	std::vector<std::unique_ptr<BenchmarkNode>> players;
+	std::vector<std::unique_ptr<BenchmarkNode>> heroes;
+	std::vector<std::unique_ptr<BenchmarkNode>> artifacts;
+	std::vector<std::unique_ptr<BenchmarkNode>> stacks;
+
+	explicit SyntheticWorld(int64_t heroesCount)
+	{
+		globalEffects = std::make_unique<BenchmarkNode>(CBonusSystemNode::GLOBAL_EFFECTS, PlayerColor::NEUTRAL);
+		for(int i = 0; i < 50; ++i)
+			globalEffects->addNewBonus(makeBonus(static_cast<BonusType>(1 + i % 100), BonusSource::OTHER, i));
+
+		auto ownerDependent = makeBonus(BonusType::MORALE, BonusSource::OTHER, -1);
+		ownerDependent->addUpdater(std::make_shared<OwnerUpdater>());
+		globalEffects->addNewBonus(ownerDependent);
+
+		for(int i = 0; i < PLAYERS; ++i)
+		{
+			players.push_back(std::make_unique<BenchmarkNode>(CBonusSystemNode::PLAYER, PlayerColor(i)));
+			players.back()->attachTo(*globalEffects);
+			players.back()->addNewBonus(makeBonus(BonusType::LUCK, BonusSource::OTHER, 1));
+		}
+
+		for(int64_t i = 0; i < heroesCount; ++i)
+			addHero(*players[i % PLAYERS]);
+	}
+
+	void addHero(BenchmarkNode & player)
+	{
+		auto & hero = heroes.emplace_back(std::make_unique<BenchmarkNode>(CBonusSystemNode::HERO, player.getOwner()));
+		hero->attachTo(player);
+
+		for(int skill = 0; skill < 4; ++skill)
+			hero->addNewBonus(makeBonus(BonusType::PRIMARY_SKILL, BonusSource::HERO_BASE_SKILL, 1 + skill, BonusSubtypeID(PrimarySkill(skill))));
+
+		for(int i = 0; i < 16; ++i)
+			hero->addNewBonus(makeBonus(static_cast<BonusType>(20 + i * 5), BonusSource::SECONDARY_SKILL, i));
+
+		// bonuses that apply to stacks only if they also have some other bonus - evaluated on every cache rebuild
+		auto limited = makeBonus(BonusType::STACKS_SPEED, BonusSource::SECONDARY_SKILL, 1);
+		limited->addLimiter(std::make_shared<HasAnotherBonusLimiter>(BonusType::FLYING));
+		hero->addNewBonus(limited);
+
+		auto aggregate = makeBonus(BonusType::STACK_HEALTH, BonusSource::SECONDARY_SKILL, 5);
+		aggregate->addLimiter(std::make_shared<AllOfLimiter>(std::vector<TLimiterPtr>{
+			std::make_shared<HasAnotherBonusLimiter>(BonusType::SHOOTER),
+			std::make_shared<AnyOfLimiter>(std::vector<TLimiterPtr>{
+				std::make_shared<HasAnotherBonusLimiter>(BonusType::FLYING),
+				std::make_shared<HasAnotherBonusLimiter>(BonusType::NO_MELEE_PENALTY)
+			})
+		}));
+		hero->addNewBonus(aggregate);
+
+		for(int i = 0; i < ARTIFACTS_PER_HERO; ++i)
+		{
+			auto & artifact = artifacts.emplace_back(std::make_unique<BenchmarkNode>(CBonusSystemNode::ARTIFACT_INSTANCE, PlayerColor::NEUTRAL));
+			artifact->addNewBonus(makeBonus(BonusType::PRIMARY_SKILL, BonusSource::ARTIFACT, i, BonusSubtypeID(PrimarySkill(i % 4))));
+			artifact->addNewBonus(makeBonus(BonusType::MORALE, BonusSource::ARTIFACT, 1));
+			artifact->addNewBonus(makeBonus(static_cast<BonusType>(50 + i), BonusSource::ARTIFACT, i));
+			hero->attachToSource(*artifact);
+		}
+
+		for(int i = 0; i < STACKS_PER_HERO; ++i)
+		{
+			auto & stack = stacks.emplace_back(std::make_unique<BenchmarkNode>(CBonusSystemNode::STACK_INSTANCE, player.getOwner()));
+			stack->attachTo(*hero);
+			stack->addNewBonus(makeBonus(BonusType::STACK_HEALTH, BonusSource::CREATURE_ABILITY, 10 + i));
+			stack->addNewBonus(makeBonus(BonusType::STACKS_SPEED, BonusSource::CREATURE_ABILITY, 5 + i));
+			if(i % 2)
+				stack->addNewBonus(makeBonus(BonusType::FLYING, BonusSource::CREATURE_ABILITY, 0));
+			if(i % 3)
+				stack->addNewBonus(makeBonus(BonusType::SHOOTER, BonusSource::CREATURE_ABILITY, 0));
+		}
+	}
+};
+
+const CSelector attackSelector = Selector::typeSubtype(BonusType::PRIMARY_SKILL, BonusSubtypeID(PrimarySkill::ATTACK));
+
+/// Repeated query of simple selector - served from request cache of the node
+void BonusCacheHit(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+	size_t index = 0;
+
+	while(state.keepRunning())
+	{
+		const auto & hero = world.heroes[index++ % world.heroes.size()];
+		Benchmark::doNotOptimize(hero->valOfBonuses(attackSelector));
+	}
+}
+
+/// Query of selector that can't be cached - filters cached bonus list of the node on every call
+void BonusCacheUncachedSelector(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+	size_t index = 0;
+
+	const CSelector selector = Selector::type()(BonusType::PRIMARY_SKILL).And([](const Bonus * b)
+	{
+		return b->val > 1;
+	});
+
+	while(state.keepRunning())
+	{
+		const auto & hero = world.heroes[index++ % world.heroes.size()];
+		Benchmark::doNotOptimize(hero->valOfBonuses(selector));
+	}
+}
+
+/// Query after change of the node - rebuilds bonus cache of the node, including updaters
+void BonusCacheMiss(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+	size_t index = 0;
+
+	while(state.keepRunning())
+	{
+		const auto & hero = world.heroes[index++ % world.heroes.size()];
+		state.pauseTiming();
+		hero->nodeHasChanged();
+		state.resumeTiming();
+		Benchmark::doNotOptimize(hero->valOfBonuses(attackSelector));
+	}
+}
+
+/// Query after change of the stack - rebuilds bonus cache of the stack, which is dominated by limiters evaluation
+void LimiterEvaluation(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+	size_t index = 0;
+
+	while(state.keepRunning())
+	{
+		const auto & stack = world.stacks[index++ % world.stacks.size()];
+		state.pauseTiming();
+		stack->nodeHasChanged();
+		state.resumeTiming();
+		Benchmark::doNotOptimize(stack->valOfBonuses(Selector::type()(BonusType::STACK_HEALTH)));
+	}
+}
+
+/// Moving stack between two heroes - propagation and invalidation, without any queries
+void AttachDetach(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+	world.addHero(*world.players.front());
+
+	auto & stack = world.stacks.front();
+	auto * first = world.heroes.front().get();
+	auto * second = world.heroes.back().get();
+
+	while(state.keepRunning())
+	{
+		stack->detachFrom(*first);
+		stack->attachTo(*second);
+		std::swap(first, second);
+	}
+}
+
+/// Change of global effects - invalidation of whole subtree, without any queries
+void GlobalNodeChange(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+
+	while(state.keepRunning())
+		world.globalEffects->nodeHasChanged();
+}
+
+/// Global invalidation followed by query on every hero and stack - worst case of e.g. new turn
+void TreeHasChanged(Benchmark::State & state)
+{
+	SyntheticWorld world(state.getSize());
+
+	while(state.keepRunning())
+	{
+		CBonusSystemNode::treeHasChanged();
+
+		for(const auto & hero : world.heroes)
+			Benchmark::doNotOptimize(hero->valOfBonuses(attackSelector));
+		for(const auto & stack : world.stacks)
+			Benchmark::doNotOptimize(stack->valOfBonuses(Selector::type()(BonusType::STACK_HEALTH)));
+	}
+}
+
+/// Filtering of large standalone bonus list, e.g. list of bonuses of a node before limiting
+void BonusListFilter(Benchmark::State & state)
+{
+	BonusList list;
+	for(int64_t i = 0; i < state.getSize(); ++i)
+		list.push_back(std::make_shared<Bonus>(BonusDuration::PERMANENT, static_cast<BonusType>(1 + i % 100), BonusSource::OTHER, i, BonusSourceID()));
+
+	while(state.keepRunning())
+		Benchmark::doNotOptimize(list.valOfBonuses(Selector::type()(BonusType::MORALE)));
+}
+
+}
+
+VCMI_BENCHMARK(BonusCacheHit, 1, 16, 128);
+VCMI_BENCHMARK(BonusCacheUncachedSelector, 1, 16, 128);
+VCMI_BENCHMARK(BonusCacheMiss, 1, 16, 128);
+VCMI_BENCHMARK(LimiterEvaluation, 1, 16, 128);
+VCMI_BENCHMARK(AttachDetach, 1, 16, 128);
+VCMI_BENCHMARK(GlobalNodeChange, 1, 16, 128);
+VCMI_BENCHMARK(TreeHasChanged, 1, 16, 128);
+VCMI_BENCHMARK(BonusListFilter, 100, 1000, 10000);
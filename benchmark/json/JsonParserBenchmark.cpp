@@ -0,0 +1,72 @@
+/*
+ * JsonParserBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "../BenchmarkHarness.h"
+
+#include "../../lib/json/JsonNode.h"
+
+namespace
+{
+
+/// Config in style of creature definitions of mods, with specified number of entries
+std::string makeConfig(int64_t size)
+{
+	std::string result = "{\n";
+	for(int64_t i = 0; i < size; ++i)
+	{
+		std::string index = std::to_string(i);
+		result += "\t// creature number " + index + "\n";
+		result += "\t\"creature" + index + "\" : {\n";
+		result += "\t\t\"name\" : { \"singular\" : \"Creature " + index + "\", \"plural\" : \"Creatures " + index + "\" },\n";
+		result += "\t\t\"level\" : " + std::to_string(i % 7 + 1) + ",\n";
+		result += "\t\t\"cost\" : { \"gold\" : " + std::to_string(100 + i) + ", \"crystal\" : 1 },\n";
+		result += "\t\t\"speed\" : 1.5e1,\n";
+		result += "\t\t\"abilities\" : {\n";
+		result += "\t\t\t\"flying\" : { \"type\" : \"FLYING\" },\n";
+		result += "\t\t\t\"noRetaliation\" : { \"type\" : \"BLOCKS_RETALIATION\", \"description\" : \"Enemy does not \\\"retaliate\\\"\" }\n";
+		result += "\t\t},\n";
+		result += "\t\t\"graphics\" : { \"animation\" : \"CPKMAN\", \"missile\" : { \"frameAngles\" : [ 90, 60, 45, 0, -45, -60, -90 ] } },\n";
+		result += "\t\t\"special\" : false,\n";
+		result += "\t\t\"upgrades\" : null\n";
+		result += i + 1 == size ? "\t}\n" : "\t},\n";
+	}
+	result += "}\n";
+	return result;
+}
+
+void benchmarkParse(Benchmark::State & state, JsonParsingSettings::JsonFormatMode mode)
+{
+	JsonParsingSettings settings;
+	settings.mode = mode;
+
+	std::string config = makeConfig(state.getSize());
+	const auto * data = reinterpret_cast<const std::byte *>(config.data());
+
+	while(state.keepRunning())
+	{
+		JsonNode node(data, config.size(), settings, "benchmark");
+		Benchmark::doNotOptimize(node);
+	}
+}
+
+void ParseJsonConfig(Benchmark::State & state)
+{
+	benchmarkParse(state, JsonParsingSettings::JsonFormatMode::JSONC);
+}
+
+void ParseJson5Config(Benchmark::State & state)
+{
+	benchmarkParse(state, JsonParsingSettings::JsonFormatMode::JSON5);
+}
+
+}
+
+VCMI_BENCHMARK(ParseJsonConfig, 10, 1000);
+VCMI_BENCHMARK(ParseJson5Config, 10, 1000);
@@ -0,0 +1,96 @@
+/*
+ * main.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BenchmarkHarness.h"
+#include "serializer/SaveGameProfiler.h"
+
+#include "../lib/CConsoleHandler.h"
+#include "../lib/VCMI_Lib.h"
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+int main(int argc, char * argv[])
+{
+	std::string filter;
+	int64_t minTimeMs = 0;
+	std::vector<int64_t> sizes;
+	std::string profiledSave;
+
+	po::options_description opts("Allowed options");
+	opts.add_options()
+		("help,h", "display help and exit")
+		("filter,f", po::value<std::string>(&filter), "run only benchmarks with name containing this string")
+		("min-time,t", po::value<int64_t>(&minTimeMs)->default_value(500), "minimal measurement time of each benchmark, in milliseconds")
+		("size,s", po::value<std::vector<int64_t>>(&sizes)->multitoken(), "override data set sizes of all benchmarks")
+		("list,l", "list available benchmarks and exit")
+		("profile-save,p", po::value<std::string>(&profiledSave), "load specified save game using installed game data and mods, and print size and timings of its serialization");
+
+	po::variables_map vm;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, opts), vm);
+		po::notify(vm);
+	}
+	catch(const po::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if(vm.count("help"))
+	{
+		std::cout << opts << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	if(!profiledSave.empty())
+	{
+		console = new CConsoleHandler();
+		preinitDLL(console, false);
+		loadDLLClasses();
+
+		try
+		{
+			SaveGameProfiler::profile(profiledSave, std::cout);
+		}
+		catch(const std::exception & e)
+		{
+			std::cerr << "Failed to profile save game:\n" << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	for(const auto & benchmark : Benchmark::getRegisteredBenchmarks())
+	{
+		if(!filter.empty() && !boost::algorithm::contains(benchmark.name, filter))
+			continue;
+
+		if(vm.count("list"))
+		{
+			std::cout << benchmark.name << std::endl;
+			continue;
+		}
+
+		for(int64_t size : sizes.empty() ? benchmark.sizes : sizes)
+		{
+			Benchmark::State state(size, std::chrono::milliseconds(minTimeMs));
+			benchmark.function(state);
+
+			std::cout << boost::format("%-50s %12d %15.1f ns\n")
+				% (benchmark.name + "/" + std::to_string(size))
+				% state.getIterations()
+				% state.getNanosecondsPerIteration();
+		}
+	}
+	return EXIT_SUCCESS;
+}
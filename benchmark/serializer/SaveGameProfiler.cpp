@@ -0,0 +1,103 @@
+/*
+ * SaveGameProfiler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "SaveGameProfiler.h"
+
+#include "../../lib/IGameCallback.h"
+#include "../../lib/gameState/CGameState.h"
+#include "../../lib/serializer/CLoadFile.h"
+#include "../../lib/serializer/CSaveFile.h"
+#include "../../lib/serializer/SerializationStatistics.h"
+
+namespace SaveGameProfiler
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// Holds library part of save game, loaded and saved in the same way as it is done by server
+class LoadedGame : public CPrivilegedInfoCallback
+{
+public:
+	LoadedGame(const boost::filesystem::path & path, SerializationStatistics * statistics)
+	{
+		CLoadFile file(path, ESerializationVersion::MINIMAL);
+		file.serializer.statistics = statistics;
+		loadCommonState(file);
+	}
+
+	~LoadedGame()
+	{
+		delete gs;
+	}
+
+	std::unique_ptr<CSaveFile> save(const boost::filesystem::path & path, SerializationStatistics * statistics) const
+	{
+		auto file = std::make_unique<CSaveFile>(path);
+		file->serializer.statistics = statistics;
+		saveCommonState(*file);
+		return file;
+	}
+};
+
+void printStep(std::ostream & out, const std::string & name, double milliseconds, uint64_t bytes)
+{
+	out << boost::format("%-40s %12.2f ms %14d bytes\n") % name % milliseconds % bytes;
+}
+
+}
+
+void profile(const boost::filesystem::path & saveFile, std::ostream & out)
+{
+	const auto tempFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vcmi-profile-%%%%%%%%.vsgm1");
+
+	SerializationStatistics loadStatistics;
+	SerializationStatistics saveStatistics;
+
+	auto start = Clock::now();
+	auto game = std::make_unique<LoadedGame>(saveFile, &loadStatistics);
+	double loadTime = millisecondsSince(start);
+
+	start = Clock::now();
+	auto save = game->save(tempFile, &saveStatistics);
+	double saveTime = millisecondsSince(start);
+
+	start = Clock::now();
+	save->writeToDisk();
+	double writeTime = millisecondsSince(start);
+
+	start = Clock::now();
+	auto reloaded = std::make_unique<LoadedGame>(tempFile, nullptr);
+	double reloadTime = millisecondsSince(start);
+
+	auto fileSize = boost::filesystem::file_size(tempFile);
+	boost::filesystem::remove(tempFile);
+
+	out << "Save game: " << saveFile.string() << "\n\n";
+	printStep(out, "Load original save", loadTime, boost::filesystem::file_size(saveFile));
+	printStep(out, "Serialize into memory", saveTime, save->serializer.bytesWritten);
+	printStep(out, "Compress and write to disk", writeTime, fileSize);
+	printStep(out, "Load written save", reloadTime, fileSize);
+
+	out << "\nSerialization, per type (excluding nested registered types):\n";
+	saveStatistics.printTable(out);
+
+	out << "\nDeserialization, per type (excluding nested registered types):\n";
+	loadStatistics.printTable(out);
+}
+
+}
@@ -0,0 +1,20 @@
+/*
+ * SaveGameProfiler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace SaveGameProfiler
+{
+
+/// Loads specified save game, saves it again and reloads saved copy, printing timings of every step
+/// along with size and (de)serialization time of every registered type that is stored in save game
+/// Requires initialized library with the same set of mods that was used to create the save
+void profile(const boost::filesystem::path & saveFile, std::ostream & out); //throws!
+
+}
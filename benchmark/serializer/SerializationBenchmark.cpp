@@ -0,0 +1,174 @@
+/*
+ * SerializationBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "../BenchmarkHarness.h"
+
+#include "../../lib/networkPacks/PacksForClient.h"
+#include "../../lib/serializer/BinaryDeserializer.h"
+#include "../../lib/serializer/BinarySerializer.h"
+
+namespace
+{
+
+/// In-memory stream that can be rewound without reallocation of its buffer
+class BenchmarkStream : public IBinaryReader, public IBinaryWriter
+{
+	std::vector<std::byte> buffer;
+	size_t readPosition = 0;
+
+public:
+	int read(std::byte * data, unsigned size) override
+	{
+		if(readPosition + size > buffer.size())
+			throw std::runtime_error("Attempt to read past the end of benchmark stream!");
+
+		std::copy_n(buffer.data() + readPosition, size, data);
+		readPosition += size;
+		return size;
+	}
+
+	int write(const std::byte * data, unsigned size) override
+	{
+		buffer.insert(buffer.end(), data, data + size);
+		return size;
+	}
+
+	void clear()
+	{
+		buffer.clear();
+		readPosition = 0;
+	}
+
+	void rewind()
+	{
+		readPosition = 0;
+	}
+};
+
+template<typename T>
+void benchmarkSave(Benchmark::State & state, const T & data)
+{
+	BenchmarkStream stream;
+
+	while(state.keepRunning())
+	{
+		stream.clear();
+		BinarySerializer serializer(&stream);
+		serializer & data;
+	}
+}
+
+template<typename T>
+void benchmarkLoad(Benchmark::State & state, const T & data)
+{
+	BenchmarkStream stream;
+	BinarySerializer serializer(&stream);
+	serializer & data;
+
+	while(state.keepRunning())
+	{
+		stream.rewind();
+		BinaryDeserializer deserializer(&stream);
+		deserializer.version = ESerializationVersion::CURRENT;
+
+		T loaded;
+		deserializer & loaded;
+		Benchmark::doNotOptimize(loaded);
+	}
+}
+
+std::vector<int32_t> makeIntegers(int64_t size)
+{
+	std::vector<int32_t> result;
+	for(int64_t i = 0; i < size; ++i)
+		result.push_back(static_cast<int32_t>((i * 7919) % 100000) - 50000);
+	return result;
+}
+
+/// Fog of war of a single player, on two-level map of specified size
+boost::multi_array<ui8, 3> makeFogOfWar(int64_t size)
+{
+	boost::multi_array<ui8, 3> result(boost::extents[size][size][2]);
+	for(size_t i = 0; i < result.num_elements(); ++i)
+		result.data()[i] = (i / 7) % 2;
+	return result;
+}
+
+std::vector<std::string> makeStrings(int64_t size)
+{
+	std::vector<std::string> result;
+	for(int64_t i = 0; i < size; ++i)
+		result.push_back("core.object." + std::to_string(i % 64));
+	return result;
+}
+
+/// Pack that is sent on every step of hero, with specified number of revealed tiles
+std::shared_ptr<CPack> makeHeroMovementPack(int64_t revealedTiles)
+{
+	auto pack = std::make_shared<TryMoveHero>();
+	pack->id = ObjectInstanceID(42);
+	pack->result = TryMoveHero::SUCCESS;
+	pack->start = int3(10, 10, 0);
+	pack->end = int3(11, 10, 0);
+	for(int64_t i = 0; i < revealedTiles; ++i)
+		pack->fowRevealed.insert(int3(i % 144, i / 144, 0));
+	return pack;
+}
+
+void SaveIntegerVector(Benchmark::State & state)
+{
+	benchmarkSave(state, makeIntegers(state.getSize()));
+}
+
+void LoadIntegerVector(Benchmark::State & state)
+{
+	benchmarkLoad(state, makeIntegers(state.getSize()));
+}
+
+void SaveFogOfWar(Benchmark::State & state)
+{
+	benchmarkSave(state, makeFogOfWar(state.getSize()));
+}
+
+void LoadFogOfWar(Benchmark::State & state)
+{
+	benchmarkLoad(state, makeFogOfWar(state.getSize()));
+}
+
+void SaveStringVector(Benchmark::State & state)
+{
+	benchmarkSave(state, makeStrings(state.getSize()));
+}
+
+void LoadStringVector(Benchmark::State & state)
+{
+	benchmarkLoad(state, makeStrings(state.getSize()));
+}
+
+void SaveHeroMovementPack(Benchmark::State & state)
+{
+	benchmarkSave(state, makeHeroMovementPack(state.getSize()));
+}
+
+void LoadHeroMovementPack(Benchmark::State & state)
+{
+	benchmarkLoad(state, makeHeroMovementPack(state.getSize()));
+}
+
+}
+
+VCMI_BENCHMARK(SaveIntegerVector, 1000, 100000);
+VCMI_BENCHMARK(LoadIntegerVector, 1000, 100000);
+VCMI_BENCHMARK(SaveFogOfWar, 36, 144, 256);
+VCMI_BENCHMARK(LoadFogOfWar, 36, 144, 256);
+VCMI_BENCHMARK(SaveStringVector, 100, 10000);
+VCMI_BENCHMARK(LoadStringVector, 100, 10000);
+VCMI_BENCHMARK(SaveHeroMovementPack, 0, 100, 1000);
+VCMI_BENCHMARK(LoadHeroMovementPack, 0, 100, 1000);
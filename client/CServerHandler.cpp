@@ -858,9 +858,21 @@ void CServerHandler::onPacketReceived(const std::shared_ptr<INetworkConnection>
 	if(getState() == EClientState::DISCONNECTING)
 		return;
 
-	auto pack = logicConnection->retrievePack(message);
-	ServerHandlerCPackVisitor visitor(*this);
-	pack->visit(visitor);
+	// server may send multiple packs in one message - unpack and apply them one by one,
+	// since deserialization of a pack may depend on game state changes made by previous packs
+	auto connection = logicConnection;
+	const auto & data = connection->unpackMessage(message);
+	size_t position = 0;
+
+	while(position < data.size())
+	{
+		auto pack = connection->retrievePack(data, position);
+		ServerHandlerCPackVisitor visitor(*this);
+		pack->visit(visitor);
+
+		if(getState() == EClientState::DISCONNECTING || logicConnection != connection)
+			return;
+	}
 }
 
 void CServerHandler::onDisconnected(const std::shared_ptr<INetworkConnection> & connection, const std::string & errorMessage)
@@ -33,6 +33,7 @@
 #include "../lib/serializer/Connection.h"
 #include "../lib/mapping/CMapService.h"
 #include "../lib/pathfinder/CGPathNode.h"
+#include "../lib/pathfinder/PathfinderCache.h"
 #include "../lib/filesystem/Filesystem.h"
 
 #include <memory>
@@ -82,6 +83,7 @@ const CPlayerEnvironment::GameCb * CPlayerEnvironment::game() const
 }
 
 CClient::CClient()
+	: pathCache(std::make_unique<PathfinderCache>(this))
 {
 	waitingRequest.clear();
 	gs = nullptr;
@@ -223,7 +225,7 @@ void CClient::initMapHandler()
 		logNetwork->trace("Creating mapHandler: %d ms", CSH->th->getDiff());
 	}
 
-	pathCache.clear();
+	pathCache->invalidatePaths();
 }
 
 void CClient::initPlayerEnvironments()
@@ -496,8 +498,14 @@ void CClient::startPlayerBattleAction(const BattleID & battleID, PlayerColor col
 
 void CClient::updatePath(const ObjectInstanceID & id)
 {
-	invalidatePaths();
 	auto hero = getHero(id);
+
+	// changes of armies that are not heroes, such as wandering monsters, may affect paths of every hero
+	if(hero)
+		invalidatePaths(hero);
+	else
+		invalidatePaths();
+
 	updatePath(hero);
 }
 
@@ -509,8 +517,12 @@ void CClient::updatePath(const CGHeroInstance * hero)
 
 void CClient::invalidatePaths()
 {
-	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
-	pathCache.clear();
+	pathCache->invalidatePaths();
+}
+
+void CClient::invalidatePaths(const CGHeroInstance * hero)
+{
+	pathCache->invalidatePaths(hero);
 }
 
 vstd::RNG & CClient::getRandomGenerator()
@@ -522,24 +534,12 @@ vstd::RNG & CClient::getRandomGenerator()
 
 std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h)
 {
-	assert(h);
-	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
-
-	auto iter = pathCache.find(h);
-
-	if(iter == std::end(pathCache))
-	{
-		auto paths = std::make_shared<CPathsInfo>(getMapSize(), h);
-
-		gs->calculatePaths(h, *paths.get());
+	return pathCache->getPathsInfo(h);
+}
 
-		pathCache[h] = paths;
-		return paths;
-	}
-	else
-	{
-		return iter->second;
-	}
+std::vector<std::shared_ptr<const CPathsInfo>> CClient::getPathsInfo(const std::vector<const CGHeroInstance *> & heroes)
+{
+	return pathCache->getPathsInfo(heroes);
 }
 
 #if SCRIPTING_ENABLED
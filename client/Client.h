@@ -23,6 +23,7 @@ class CGameInterface;
 class BattleAction;
 class BattleInfo;
 struct BankConfig;
+class PathfinderCache;
 
 #if SCRIPTING_ENABLED
 namespace scripting
@@ -149,10 +150,12 @@ public:
 	void battleFinished(const BattleID & battleID);
 	void startPlayerBattleAction(const BattleID & battleID, PlayerColor color);
 
-	void invalidatePaths(); // clears this->pathCache()
-	void updatePath(const ObjectInstanceID & heroID); // invalidatePaths and update displayed hero path 
+	void invalidatePaths(); // clears paths of all heroes from this->pathCache
+	void invalidatePaths(const CGHeroInstance * hero); // clears paths of specific hero, for changes that don't affect other heroes
+	void updatePath(const ObjectInstanceID & heroID); // invalidatePaths of hero and update displayed hero path 
 	void updatePath(const CGHeroInstance * hero);
 	std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
+	std::vector<std::shared_ptr<const CPathsInfo>> getPathsInfo(const std::vector<const CGHeroInstance *> & heroes);
 
 	friend class CCallback; //handling players actions
 	friend class CBattleCallback; //handling players actions
@@ -235,8 +238,7 @@ private:
 #endif
 	std::unique_ptr<events::EventBus> clientEventBus;
 
-	mutable boost::mutex pathCacheMutex;
-	std::map<const CGHeroInstance *, std::shared_ptr<CPathsInfo>> pathCache;
+	std::unique_ptr<PathfinderCache> pathCache;
 
 	void reinitScripting();
 };
@@ -278,6 +278,14 @@ void AdventureMapShortcuts::endTurn()
 
 	if(settings["adventure"]["heroReminder"].Bool())
 	{
+		// calculate paths of all heroes that need verification in one batch, instead of one by one in verifyPath
+		// result is kept in path cache of the client, verifyPath below takes paths from there while heroes stay unchanged
+		std::vector<const CGHeroInstance *> heroesToVerify;
+		for(auto hero : LOCPLINT->localState->getWanderingHeroes())
+			if(!LOCPLINT->localState->isHeroSleeping(hero) && hero->movementPointsRemaining() > 0 && LOCPLINT->localState->hasPath(hero))
+				heroesToVerify.push_back(hero);
+		LOCPLINT->cb->getPathsInfo(heroesToVerify);
+
 		for(auto hero : LOCPLINT->localState->getWanderingHeroes())
 		{
 			if(!LOCPLINT->localState->isHeroSleeping(hero) && hero->movementPointsRemaining() > 0)
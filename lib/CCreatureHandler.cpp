@@ -334,6 +334,7 @@ void CCreature::addBonus(int val, BonusType type, BonusSubtypeID subtype)
 	{
 		std::shared_ptr<Bonus> b = existing[0];
 		b->val = val;
+		nodeHasChanged();
 	}
 }
 
@@ -955,6 +955,11 @@ void CGameInfoCallback::calculatePaths( const CGHeroInstance *hero, CPathsInfo &
 	gs->calculatePaths(hero, out);
 }
 
+void CGameInfoCallback::calculatePaths(const std::vector<CPathsInfo *> & out)
+{
+	gs->calculatePaths(out);
+}
+
 const CArtifactInstance * CGameInfoCallback::getArtInstance( ArtifactInstanceID aid ) const
 {
 	return gs->map->artInstances[aid.num];
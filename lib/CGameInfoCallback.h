@@ -209,6 +209,7 @@ public:
 	virtual void getVisibleTilesInRange(std::unordered_set<int3> &tiles, int3 pos, int radious, int3::EDistanceFormula distanceFormula = int3::DIST_2D) const;
 	virtual void calculatePaths(const std::shared_ptr<PathfinderConfig> & config);
 	virtual void calculatePaths(const CGHeroInstance *hero, CPathsInfo &out);
+	virtual void calculatePaths(const std::vector<CPathsInfo *> & out);
 	virtual EDiggingStatus getTileDigStatus(int3 tile, bool verbose = true) const;
 
 	//town
@@ -212,6 +212,7 @@ void CPrivilegedInfoCallback::saveCommonState(CSaveFile & out) const
 	out.serializer & static_cast<CMapHeader&>(*gs->map);
 	logGlobal->info("\tSaving options");
 	out.serializer & gs->scenarioOps;
+	out.markHeaderEnd();
 	logGlobal->info("\tSaving mod list");
 	out.serializer & activeMods;
 	logGlobal->info("\tSaving gamestate");
@@ -21,6 +21,7 @@
 #include "mapping/CMapHeader.h"
 #include "mapping/CMapService.h"
 #include "modding/ModIncompatibility.h"
+#include "serializer/CMemorySerializer.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
@@ -104,6 +105,19 @@ bool StartInfo::isSteadwickFallCampaignMission() const
 	return true;
 }
 
+std::unique_ptr<StartInfo> StartInfo::clone() const
+{
+	auto result = std::make_unique<StartInfo>(*this);
+
+	// options of random map and campaign state are rarely present and large, copy them via serialization
+	if(mapGenOptions)
+		result->mapGenOptions = CMemorySerializer::deepCopy(*mapGenOptions);
+	if(campState)
+		result->campState = CMemorySerializer::deepCopy(*campState);
+
+	return result;
+}
+
 void LobbyInfo::verifyStateBeforeStart(bool ignoreNoHuman) const
 {
 	if(!mi || !mi->mapHeader)
@@ -167,6 +167,9 @@ struct DLL_LINKAGE StartInfo : public Serializeable
 	/// Controls hardcoded check for "Steadwick's Fall" scenario from "Dungeon and Devils" campaign
 	bool isSteadwickFallCampaignMission() const;
 
+	/// Creates independent copy of start info, used instead of serialization round trip by CMemorySerializer::deepCopy
+	std::unique_ptr<StartInfo> clone() const;
+
 	template <typename Handler>
 	void serialize(Handler &h)
 	{
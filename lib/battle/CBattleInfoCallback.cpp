@@ -242,10 +242,10 @@ bool CBattleInfoCallback::battleHasWallPenalty(const IBonusBearer * shooter, Bat
 	if(battleGetFortifications().wallsHealth == 0)
 		return false;
 
-	const std::string cachingStrNoWallPenalty = "type_NO_WALL_PENALTY";
+	static const auto cachingKeyNoWallPenalty = BonusCacheKey::type(BonusType::NO_WALL_PENALTY);
 	static const auto selectorNoWallPenalty = Selector::type()(BonusType::NO_WALL_PENALTY);
 
-	if(shooter->hasBonus(selectorNoWallPenalty, cachingStrNoWallPenalty))
+	if(shooter->hasBonus(selectorNoWallPenalty, cachingKeyNoWallPenalty))
 		return false;
 
 	const auto shooterOutsideWalls = shooterPosition < lineToWallHex(shooterPosition.getY());
@@ -1593,10 +1593,10 @@ bool CBattleInfoCallback::battleHasDistancePenalty(const IBonusBearer * shooter,
 {
 	RETURN_IF_NOT_BATTLE(false);
 
-	const std::string cachingStrNoDistancePenalty = "type_NO_DISTANCE_PENALTY";
+	static const auto cachingKeyNoDistancePenalty = BonusCacheKey::type(BonusType::NO_DISTANCE_PENALTY);
 	static const auto selectorNoDistancePenalty = Selector::type()(BonusType::NO_DISTANCE_PENALTY);
 
-	if(shooter->hasBonus(selectorNoDistancePenalty, cachingStrNoDistancePenalty))
+	if(shooter->hasBonus(selectorNoDistancePenalty, cachingKeyNoDistancePenalty))
 		return false;
 
 	if(const auto * target = battleGetUnitByPos(destHex, true))
@@ -1788,10 +1788,9 @@ SpellID CBattleInfoCallback::getRandomBeneficialSpell(vstd::RNG & rand, const ba
 
 	for(const SpellID& spellID : allPossibleSpells)
 	{
-		std::stringstream cachingStr;
-		cachingStr << "source_" << vstd::to_underlying(BonusSource::SPELL_EFFECT) << "id_" << spellID.num;
+		const auto cachingKey = BonusCacheKey::source(BonusSource::SPELL_EFFECT, BonusSourceID(spellID));
 
-		if(subject->hasBonus(Selector::source(BonusSource::SPELL_EFFECT, BonusSourceID(spellID)), Selector::all, cachingStr.str()))
+		if(subject->hasBonus(Selector::source(BonusSource::SPELL_EFFECT, BonusSourceID(spellID)), Selector::all, cachingKey))
 			continue;
 
 		auto spellPtr = spellID.toSpell();
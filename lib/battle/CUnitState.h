@@ -283,7 +283,7 @@ public:
 	explicit CUnitStateDetached(const IUnitInfo * unit_, const IBonusBearer * bonus_);
 
 	TConstBonusListPtr getAllBonuses(const CSelector & selector, const CSelector & limit,
-		const std::string & cachingStr = "") const override;
+		const BonusCacheKey & cachingKey = {}) const override;
 
 	int64_t getTreeVersion() const override;
 
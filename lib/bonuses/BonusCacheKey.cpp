@@ -0,0 +1,60 @@
+/*
+ * BonusCacheKey.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "BonusCacheKey.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+BonusCacheKey::BonusCacheKey(EKind kind, BonusType type, BonusSource source, int32_t number, size_t numberTypeIndex, int32_t info)
+{
+	assert(numberTypeIndex < 0x100);
+	assert(info >= 0 && info < 0x10);
+
+	value = static_cast<uint32_t>(number);
+	value |= static_cast<uint64_t>(vstd::to_underlying(type)) << 32;
+	value |= static_cast<uint64_t>(vstd::to_underlying(source)) << 40;
+	value |= static_cast<uint64_t>(numberTypeIndex) << 48;
+	value |= static_cast<uint64_t>(info) << 56;
+	value |= static_cast<uint64_t>(vstd::to_underlying(kind)) << 60;
+}
+
+BonusCacheKey BonusCacheKey::type(BonusType type)
+{
+	return BonusCacheKey(EKind::TYPE, type, BonusSource::OTHER, 0, 0, 0);
+}
+
+BonusCacheKey BonusCacheKey::typeSubtype(BonusType type, BonusSubtypeID subtype)
+{
+	return BonusCacheKey(EKind::TYPE_SUBTYPE, type, BonusSource::OTHER, subtype.getNum(), subtype.getTypeIndex(), 0);
+}
+
+BonusCacheKey BonusCacheKey::typeSubtypeInfo(BonusType type, BonusSubtypeID subtype, int32_t info)
+{
+	return BonusCacheKey(EKind::TYPE_SUBTYPE_INFO, type, BonusSource::OTHER, subtype.getNum(), subtype.getTypeIndex(), info);
+}
+
+BonusCacheKey BonusCacheKey::sourceType(BonusSource source)
+{
+	return BonusCacheKey(EKind::SOURCE_TYPE, BonusType::NONE, source, 0, 0, 0);
+}
+
+BonusCacheKey BonusCacheKey::source(BonusSource source, BonusSourceID sourceID)
+{
+	return BonusCacheKey(EKind::SOURCE, BonusType::NONE, source, sourceID.getNum(), sourceID.getTypeIndex(), 0);
+}
+
+BonusCacheKey BonusCacheKey::unique()
+{
+	static std::atomic<int32_t> lastUniqueKey(0);
+	return BonusCacheKey(EKind::UNIQUE, BonusType::NONE, BonusSource::OTHER, ++lastUniqueKey, 0, 0);
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,76 @@
+/*
+ * BonusCacheKey.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "Bonus.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Compact, hashable identifier of bonus query, used to cache query results in bonus system nodes
+/// Key must describe selector of the query exactly - two different selectors must never share the same key
+class DLL_LINKAGE BonusCacheKey
+{
+	enum class EKind : uint8_t
+	{
+		NONE,
+		TYPE,
+		TYPE_SUBTYPE,
+		TYPE_SUBTYPE_INFO,
+		SOURCE_TYPE,
+		SOURCE,
+		UNIQUE
+	};
+
+	// bits 0-31: identifier number, 32-39: bonus type, 40-47: bonus source,
+	// 48-55: identifier type index, 56-59: additional info, 60-63: kind
+	uint64_t value = 0;
+
+	BonusCacheKey(EKind kind, BonusType type, BonusSource source, int32_t number, size_t numberTypeIndex, int32_t info);
+
+public:
+	/// Creates empty key - results of such queries are never cached
+	BonusCacheKey() = default;
+
+	/// Key for Selector::type()(type)
+	static BonusCacheKey type(BonusType type);
+	/// Key for Selector::typeSubtype(type, subtype)
+	static BonusCacheKey typeSubtype(BonusType type, BonusSubtypeID subtype);
+	/// Key for Selector::typeSubtypeInfo(type, subtype, info), only small non-negative values of info are supported
+	static BonusCacheKey typeSubtypeInfo(BonusType type, BonusSubtypeID subtype, int32_t info);
+	/// Key for Selector::sourceType()(source)
+	static BonusCacheKey sourceType(BonusSource source);
+	/// Key for Selector::source(source, sourceID)
+	static BonusCacheKey source(BonusSource source, BonusSourceID sourceID);
+	/// Generates new key that is different from any other key. Intended for complex selectors stored in static variables
+	static BonusCacheKey unique();
+
+	bool empty() const
+	{
+		return value == 0;
+	}
+
+	uint64_t hash() const
+	{
+		// fibonacci hashing - spreads keys that differ only in high bits (type, source) over the table
+		return value * 0x9E3779B97F4A7C15ull;
+	}
+
+	bool operator==(const BonusCacheKey & other) const
+	{
+		return value == other.value;
+	}
+
+	bool operator!=(const BonusCacheKey & other) const
+	{
+		return value != other.value;
+	}
+};
+
+VCMI_LIB_NAMESPACE_END
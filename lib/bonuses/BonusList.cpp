@@ -14,34 +14,100 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-BonusList::BonusList(bool BelongsToTree) : belongsToTree(BelongsToTree)
+BonusList::BonusList(const CBonusSystemNode * Owner) : owner(Owner)
 {
 }
 
-BonusList::BonusList(const BonusList & bonusList): belongsToTree(false)
+BonusList::BonusList(const BonusList & bonusList): owner(nullptr)
 {
 	bonuses.resize(bonusList.size());
 	std::copy(bonusList.begin(), bonusList.end(), bonuses.begin());
 }
 
-BonusList::BonusList(BonusList && other) noexcept: belongsToTree(false)
+BonusList::BonusList(BonusList && other) noexcept: owner(nullptr)
 {
-	std::swap(belongsToTree, other.belongsToTree);
+	std::swap(owner, other.owner);
 	std::swap(bonuses, other.bonuses);
+	std::swap(typeIndex, other.typeIndex);
 }
 
 BonusList& BonusList::operator=(const BonusList &bonusList)
 {
 	bonuses.resize(bonusList.size());
 	std::copy(bonusList.begin(), bonusList.end(), bonuses.begin());
-	belongsToTree = false;
+	owner = nullptr;
+	rebuildTypeIndex();
 	return *this;
 }
 
 void BonusList::changed() const
 {
-    if(belongsToTree)
-		CBonusSystemNode::treeHasChanged();
+	if(owner)
+		owner->nodeHasChanged();
+}
+
+void BonusList::enableTypeIndex()
+{
+	if(typeIndex)
+		return;
+
+	typeIndex = std::make_unique<TypeIndex>();
+	rebuildTypeIndex();
+}
+
+void BonusList::rebuildTypeIndex()
+{
+	if(!typeIndex)
+		return;
+
+	typeIndex->chains.clear();
+	typeIndex->next.clear();
+	typeIndex->next.reserve(bonuses.capacity());
+	for(uint32_t position = 0; position < bonuses.size(); ++position)
+		indexBonus(position);
+}
+
+void BonusList::indexBonus(uint32_t position)
+{
+	assert(typeIndex);
+	assert(position == typeIndex->next.size());
+
+	typeIndex->next.push_back(TypeIndex::NONE);
+	if(!bonuses[position])
+		return;
+
+	const size_t type = vstd::to_underlying(bonuses[position]->type);
+	if(type >= typeIndex->chains.size())
+		typeIndex->chains.resize(type + 1, {TypeIndex::NONE, TypeIndex::NONE});
+
+	auto & chain = typeIndex->chains[type];
+	if(chain.second == TypeIndex::NONE)
+		chain.first = position;
+	else
+		typeIndex->next[chain.second] = position;
+	chain.second = position;
+}
+
+template<typename Visitor>
+void BonusList::visitCandidates(const CSelector & selector, const Visitor & visitor) const
+{
+	const auto requiredType = typeIndex ? selector.getRequiredType() : std::nullopt;
+
+	if(!requiredType)
+	{
+		for(const auto & b : bonuses)
+			if(visitor(b))
+				return;
+		return;
+	}
+
+	const size_t type = vstd::to_underlying(*requiredType);
+	if(type >= typeIndex->chains.size())
+		return;
+
+	for(uint32_t position = typeIndex->chains[type].first; position != TypeIndex::NONE; position = typeIndex->next[position])
+		if(visitor(bonuses[position]))
+			return;
 }
 
 void BonusList::stackBonuses()
@@ -81,6 +147,7 @@ void BonusList::stackBonuses()
 		else
 			next++;
 	}
+	rebuildTypeIndex();
 }
 
 int BonusList::totalValue() const
@@ -175,32 +242,42 @@ int BonusList::totalValue() const
 
 std::shared_ptr<Bonus> BonusList::getFirst(const CSelector &select)
 {
-	for (auto & b : bonuses)
+	std::shared_ptr<Bonus> result;
+	visitCandidates(select, [&](const std::shared_ptr<Bonus> & b)
 	{
 		if(select(b.get()))
-			return b;
-	}
-	return nullptr;
+			result = b;
+		return result != nullptr;
+	});
+	return result;
 }
 
 std::shared_ptr<const Bonus> BonusList::getFirst(const CSelector &selector) const
 {
-	for(const auto & b : bonuses)
+	std::shared_ptr<const Bonus> result;
+	visitCandidates(selector, [&](const std::shared_ptr<Bonus> & b)
 	{
 		if(selector(b.get()))
-			return b;
-	}
-	return nullptr;
+			result = b;
+		return result != nullptr;
+	});
+	return result;
 }
 
 void BonusList::getBonuses(BonusList & out, const CSelector &selector, const CSelector &limit) const
 {
-	out.reserve(bonuses.size());
-	for(const auto & b : bonuses)
+	// both selector and limit must match, so required type of either one can be used to narrow down search
+	const CSelector & indexed = !selector.getRequiredType() && limit ? limit : selector;
+
+	if(!typeIndex || !indexed.getRequiredType())
+		out.reserve(bonuses.size());
+
+	visitCandidates(indexed, [&](const std::shared_ptr<Bonus> & b)
 	{
-		if(selector(b.get()) && (!limit || ((bool)limit && limit(b.get()))))
+		if(selector(b.get()) && (!limit || limit(b.get())))
 			out.push_back(b);
-	}
+		return false;
+	});
 }
 
 void BonusList::getAllBonuses(BonusList &out) const
@@ -228,18 +305,23 @@ JsonNode BonusList::toJsonNode() const
 void BonusList::push_back(const std::shared_ptr<Bonus> & x)
 {
 	bonuses.push_back(x);
+	if(typeIndex)
+		indexBonus(bonuses.size() - 1);
 	changed();
 }
 
 BonusList::TInternalContainer::iterator BonusList::erase(const int position)
 {
 	changed();
-	return bonuses.erase(bonuses.begin() + position);
+	auto result = bonuses.erase(bonuses.begin() + position);
+	rebuildTypeIndex();
+	return result;
 }
 
 void BonusList::clear()
 {
 	bonuses.clear();
+	rebuildTypeIndex();
 	changed();
 }
 
@@ -249,6 +331,7 @@ std::vector<BonusList *>::size_type BonusList::operator-=(const std::shared_ptr<
 	if(itr == bonuses.end())
 		return false;
 	bonuses.erase(itr);
+	rebuildTypeIndex();
 	changed();
 	return true;
 }
@@ -256,6 +339,7 @@ std::vector<BonusList *>::size_type BonusList::operator-=(const std::shared_ptr<
 void BonusList::resize(BonusList::TInternalContainer::size_type sz, const std::shared_ptr<Bonus> & c)
 {
 	bonuses.resize(sz, c);
+	rebuildTypeIndex();
 	changed();
 }
 
@@ -267,6 +351,7 @@ void BonusList::reserve(TInternalContainer::size_type sz)
 void BonusList::insert(BonusList::TInternalContainer::iterator position, BonusList::TInternalContainer::size_type n, const std::shared_ptr<Bonus> & x)
 {
 	bonuses.insert(position, n, x);
+	rebuildTypeIndex();
 	changed();
 }
 
@@ -14,6 +14,8 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+class CBonusSystemNode;
+
 class DLL_LINKAGE BonusList
 {
 public:
@@ -21,9 +23,26 @@ public:
 
 private:
 	TInternalContainer bonuses;
-	bool belongsToTree;
+	const CBonusSystemNode * owner; // node that must be invalidated on any change of this list, if any
 	void changed() const;
 
+	/// Optional secondary index that chains together all bonuses of the same type
+	struct TypeIndex
+	{
+		static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+		std::vector<std::pair<uint32_t, uint32_t>> chains; // first and last position of bonuses of each type
+		std::vector<uint32_t> next; // position of next bonus of the same type, for each bonus in list
+	};
+	std::unique_ptr<TypeIndex> typeIndex;
+
+	void indexBonus(uint32_t position);
+	void rebuildTypeIndex();
+
+	/// Calls visitor for all bonuses that may match selector, in list order. Stops once visitor returns true
+	template<typename Visitor>
+	void visitCandidates(const CSelector & selector, const Visitor & visitor) const;
+
 public:
 	using const_reference = TInternalContainer::const_reference;
 	using value_type = TInternalContainer::value_type;
@@ -31,7 +50,7 @@ public:
 	using const_iterator = TInternalContainer::const_iterator;
 	using iterator = TInternalContainer::iterator;
 
-	BonusList(bool BelongsToTree = false);
+	explicit BonusList(const CBonusSystemNode * Owner = nullptr);
 	BonusList(const BonusList &bonusList);
 	BonusList(BonusList && other) noexcept;
 	BonusList& operator=(const BonusList &bonusList);
@@ -57,6 +76,12 @@ public:
 	TInternalContainer::const_iterator end() const { return bonuses.end(); }
 	TInternalContainer::size_type operator-=(const std::shared_ptr<Bonus> & i);
 
+	/// Enables index of bonuses by type, so selectors with known required type only visit matching bonuses
+	/// Index is kept in sync on all modifications done through BonusList, but not on in-place replacement
+	/// of bonuses via non-const accessors - such lists must not have index enabled
+	void enableTypeIndex();
+	bool hasTypeIndex() const { return typeIndex != nullptr; }
+
 	// BonusList functions
 	void stackBonuses();
 	int totalValue() const;
@@ -84,6 +109,7 @@ public:
 		bonuses.clear();
 		bonuses.resize(newList.size());
 		std::copy(newList.begin(), newList.end(), bonuses.begin());
+		rebuildTypeIndex();
 	}
 
 	template <class InputIterator>
@@ -13,6 +13,373 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+CSelector CSelector::fromProgram(std::shared_ptr<const Program> program)
+{
+	CSelector result;
+	result.program = std::move(program);
+	return result;
+}
+
+CSelector CSelector::leaf(EOperation operation, int32_t value)
+{
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({operation, 1, value});
+	result->finalize();
+	return fromProgram(result);
+}
+
+CSelector CSelector::fromFunction(TFunction function)
+{
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({EOperation::FUNCTION, 1, 0});
+	result->functions.push_back(std::move(function));
+	result->finalize();
+	return fromProgram(result);
+}
+
+CSelector CSelector::constant(bool value)
+{
+	return leaf(value ? EOperation::ALL : EOperation::NONE, 0);
+}
+
+CSelector CSelector::willLastTurns(int turns)
+{
+	return leaf(EOperation::WILL_LAST_TURNS, turns);
+}
+
+CSelector CSelector::willLastDays(int days)
+{
+	return leaf(EOperation::WILL_LAST_DAYS, days);
+}
+
+CSelector CSelector::fieldEqual(BonusType Bonus::*field, const BonusType & value)
+{
+	if(field == &Bonus::type)
+		return leaf(EOperation::TYPE, vstd::to_underlying(value));
+	return fieldEqual<BonusType>(field, value);
+}
+
+CSelector CSelector::fieldEqual(BonusSubtypeID Bonus::*field, const BonusSubtypeID & value)
+{
+	if(field != &Bonus::subtype)
+		return fieldEqual<BonusSubtypeID>(field, value);
+
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({EOperation::SUBTYPE, 1, 0});
+	result->subtypes.push_back(value);
+	result->finalize();
+	return fromProgram(result);
+}
+
+CSelector CSelector::fieldEqual(CAddInfo Bonus::*field, const CAddInfo & value)
+{
+	if(field != &Bonus::additionalInfo)
+		return fieldEqual<CAddInfo>(field, value);
+
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({EOperation::INFO, 1, 0});
+	result->infos.push_back(value);
+	result->finalize();
+	return fromProgram(result);
+}
+
+CSelector CSelector::fieldEqual(BonusSource Bonus::*field, const BonusSource & value)
+{
+	if(field == &Bonus::source)
+		return leaf(EOperation::SOURCE, vstd::to_underlying(value));
+	if(field == &Bonus::targetSourceType)
+		return leaf(EOperation::TARGET_SOURCE, vstd::to_underlying(value));
+	return fieldEqual<BonusSource>(field, value);
+}
+
+CSelector CSelector::fieldEqual(BonusSourceID Bonus::*field, const BonusSourceID & value)
+{
+	if(field != &Bonus::sid)
+		return fieldEqual<BonusSourceID>(field, value);
+
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({EOperation::SOURCE_ID, 1, 0});
+	result->sourceIDs.push_back(value);
+	result->finalize();
+	return fromProgram(result);
+}
+
+CSelector CSelector::fieldEqual(BonusValueType Bonus::*field, const BonusValueType & value)
+{
+	if(field == &Bonus::valType)
+		return leaf(EOperation::VALUE_TYPE, vstd::to_underlying(value));
+	return fieldEqual<BonusValueType>(field, value);
+}
+
+CSelector CSelector::fieldEqual(BonusLimitEffect Bonus::*field, const BonusLimitEffect & value)
+{
+	if(field == &Bonus::effectRange)
+		return leaf(EOperation::EFFECT_RANGE, vstd::to_underlying(value));
+	return fieldEqual<BonusLimitEffect>(field, value);
+}
+
+bool CSelector::isOperation(EOperation operation) const
+{
+	return program && program->instructions.front().operation == operation;
+}
+
+bool CSelector::isAll() const
+{
+	return isOperation(EOperation::ALL);
+}
+
+std::optional<BonusType> CSelector::getRequiredType() const
+{
+	if(!program)
+		return std::nullopt;
+	return program->requiredType;
+}
+
+BonusCacheKey CSelector::getCacheKey() const
+{
+	if(!program)
+		return BonusCacheKey();
+	return program->cacheKey;
+}
+
+CSelector CSelector::And(CSelector rhs) const
+{
+	// all.And(x) is common result of selector parsing - no need to evaluate it
+	if(isAll())
+		return rhs;
+	if(rhs.isAll())
+		return *this;
+	return combine(EOperation::AND, rhs);
+}
+
+CSelector CSelector::Or(CSelector rhs) const
+{
+	if(isOperation(EOperation::NONE))
+		return rhs;
+	if(rhs.isOperation(EOperation::NONE))
+		return *this;
+	return combine(EOperation::OR, rhs);
+}
+
+CSelector CSelector::Not() const
+{
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({EOperation::NOT, 0, 0});
+
+	if(program)
+		result->append(*program, 0, program->instructions.size());
+	else
+		result->append(*fromFunction(nullptr).program, 0, 1);
+
+	result->instructions.front().length = result->instructions.size();
+	result->finalize();
+	return fromProgram(result);
+}
+
+CSelector CSelector::combine(EOperation operation, const CSelector & rhs) const
+{
+	auto result = std::make_shared<Program>();
+	result->instructions.push_back({operation, 0, 0});
+
+	for(const auto * operand : {this, &rhs})
+	{
+		// empty selector behaves like empty std::function - throws on evaluation
+		const auto & operandProgram = operand->program ? *operand->program : *fromFunction(nullptr).program;
+
+		// flatten nested operations of the same kind, so a.And(b).And(c) is evaluated in a single loop
+		if(operandProgram.instructions.front().operation == operation)
+			result->append(operandProgram, 1, operandProgram.instructions.size());
+		else
+			result->append(operandProgram, 0, operandProgram.instructions.size());
+	}
+
+	result->instructions.front().length = result->instructions.size();
+	result->finalize();
+	return fromProgram(result);
+}
+
+void CSelector::Program::append(const Program & other, size_t begin, size_t end)
+{
+	const auto subtypesOffset = static_cast<int32_t>(subtypes.size());
+	const auto sourceIDsOffset = static_cast<int32_t>(sourceIDs.size());
+	const auto infosOffset = static_cast<int32_t>(infos.size());
+	const auto functionsOffset = static_cast<int32_t>(functions.size());
+
+	for(size_t i = begin; i < end; ++i)
+	{
+		Instruction instruction = other.instructions[i];
+		switch(instruction.operation)
+		{
+			case EOperation::SUBTYPE:
+				instruction.value += subtypesOffset;
+				break;
+			case EOperation::SOURCE_ID:
+				instruction.value += sourceIDsOffset;
+				break;
+			case EOperation::INFO:
+				instruction.value += infosOffset;
+				break;
+			case EOperation::FUNCTION:
+				instruction.value += functionsOffset;
+				break;
+		}
+		instructions.push_back(instruction);
+	}
+
+	vstd::concatenate(subtypes, other.subtypes);
+	vstd::concatenate(sourceIDs, other.sourceIDs);
+	vstd::concatenate(infos, other.infos);
+	vstd::concatenate(functions, other.functions);
+}
+
+void CSelector::Program::finalize()
+{
+	requiredType = getRequiredType(0);
+
+	// Selector is simple enough to be described by cache key if it is a single comparison or a conjunction of comparisons
+	const auto & root = instructions.front();
+	size_t begin = root.operation == EOperation::AND ? 1 : 0;
+
+	std::optional<BonusType> type;
+	std::optional<BonusSource> source;
+	std::optional<BonusSubtypeID> subtype;
+	std::optional<BonusSourceID> sourceID;
+	std::optional<CAddInfo> info;
+	bool inspectable = true;
+
+	for(size_t i = begin; i < instructions.size(); i += instructions[i].length)
+	{
+		const auto & instruction = instructions[i];
+		switch(instruction.operation)
+		{
+			case EOperation::TYPE:
+				type = static_cast<BonusType>(instruction.value);
+				break;
+			case EOperation::SUBTYPE:
+				subtype = subtypes[instruction.value];
+				break;
+			case EOperation::INFO:
+				info = infos[instruction.value];
+				break;
+			case EOperation::SOURCE:
+				source = static_cast<BonusSource>(instruction.value);
+				break;
+			case EOperation::SOURCE_ID:
+				sourceID = sourceIDs[instruction.value];
+				break;
+			default:
+				inspectable = false;
+		}
+	}
+
+	if(!inspectable || (root.operation != EOperation::AND && instructions.size() != 1))
+		return;
+
+	// repeated comparisons of the same field are not detected, so only accept conjunctions of distinct fields
+	size_t comparisons = instructions.size() - begin;
+	size_t fields = type.has_value() + subtype.has_value() + info.has_value() + source.has_value() + sourceID.has_value();
+	if(comparisons != fields)
+		return;
+
+	if(type && !source && !sourceID)
+	{
+		if(!subtype && !info)
+			cacheKey = BonusCacheKey::type(*type);
+		else if(subtype && !info)
+			cacheKey = BonusCacheKey::typeSubtype(*type, *subtype);
+		else if(subtype && info && info->size() == 1 && (*info)[0] >= 0 && (*info)[0] < 0x10)
+			cacheKey = BonusCacheKey::typeSubtypeInfo(*type, *subtype, (*info)[0]);
+	}
+
+	if(source && !type && !subtype && !info)
+	{
+		if(sourceID)
+			cacheKey = BonusCacheKey::source(*source, *sourceID);
+		else
+			cacheKey = BonusCacheKey::sourceType(*source);
+	}
+}
+
+std::optional<BonusType> CSelector::Program::getRequiredType(size_t index) const
+{
+	const auto & instruction = instructions[index];
+	switch(instruction.operation)
+	{
+		case EOperation::TYPE:
+			return static_cast<BonusType>(instruction.value);
+		case EOperation::AND:
+			for(size_t child = index + 1; child < index + instruction.length; child += instructions[child].length)
+			{
+				auto childType = getRequiredType(child);
+				if(childType)
+					return childType;
+			}
+			return std::nullopt;
+		case EOperation::OR:
+		{
+			std::optional<BonusType> result;
+			for(size_t child = index + 1; child < index + instruction.length; child += instructions[child].length)
+			{
+				auto childType = getRequiredType(child);
+				if(!childType || (result && result != childType))
+					return std::nullopt;
+				result = childType;
+			}
+			return result;
+		}
+		default:
+			return std::nullopt;
+	}
+}
+
+bool CSelector::Program::evaluate(size_t index, const Bonus * b) const
+{
+	const auto & instruction = instructions[index];
+	switch(instruction.operation)
+	{
+		case EOperation::ALL:
+			return true;
+		case EOperation::NONE:
+			return false;
+		case EOperation::AND:
+			for(size_t child = index + 1; child < index + instruction.length; child += instructions[child].length)
+				if(!evaluate(child, b))
+					return false;
+			return true;
+		case EOperation::OR:
+			for(size_t child = index + 1; child < index + instruction.length; child += instructions[child].length)
+				if(evaluate(child, b))
+					return true;
+			return false;
+		case EOperation::NOT:
+			return !evaluate(index + 1, b);
+		case EOperation::TYPE:
+			return b->type == static_cast<BonusType>(instruction.value);
+		case EOperation::SUBTYPE:
+			return b->subtype == subtypes[instruction.value];
+		case EOperation::INFO:
+			return b->additionalInfo == infos[instruction.value];
+		case EOperation::SOURCE:
+			return b->source == static_cast<BonusSource>(instruction.value);
+		case EOperation::SOURCE_ID:
+			return b->sid == sourceIDs[instruction.value];
+		case EOperation::TARGET_SOURCE:
+			return b->targetSourceType == static_cast<BonusSource>(instruction.value);
+		case EOperation::VALUE_TYPE:
+			return b->valType == static_cast<BonusValueType>(instruction.value);
+		case EOperation::EFFECT_RANGE:
+			return b->effectRange == static_cast<BonusLimitEffect>(instruction.value);
+		case EOperation::WILL_LAST_TURNS:
+			return CWillLastTurns(instruction.value)(b);
+		case EOperation::WILL_LAST_DAYS:
+			return CWillLastDays(instruction.value)(b);
+		case EOperation::FUNCTION:
+			return functions[instruction.value](b);
+	}
+	assert(0);
+	return false;
+}
+
 namespace Selector
 {
 	DLL_LINKAGE const CSelectFieldEqual<BonusType> & type()
@@ -51,14 +418,14 @@ namespace Selector
 		return seffectRange;
 	}
 
-	DLL_LINKAGE CWillLastTurns turns(int turns)
+	DLL_LINKAGE CSelector turns(int turns)
 	{
-		return CWillLastTurns(turns);
+		return CSelector::willLastTurns(turns);
 	}
 
-	DLL_LINKAGE CWillLastDays days(int days)
+	DLL_LINKAGE CSelector days(int days)
 	{
-		return CWillLastDays(days);
+		return CSelector::willLastDays(days);
 	}
 
 	CSelector DLL_LINKAGE typeSubtype(BonusType Type, BonusSubtypeID Subtype)
@@ -96,8 +463,8 @@ namespace Selector
 				.And(valueType(valType));
 	}
 
-	DLL_LINKAGE CSelector all([](const Bonus * b){return true;});
-	DLL_LINKAGE CSelector none([](const Bonus * b){return false;});
+	DLL_LINKAGE CSelector all = CSelector::constant(true);
+	DLL_LINKAGE CSelector none = CSelector::constant(false);
 }
 
 VCMI_LIB_NAMESPACE_END
@@ -11,51 +11,123 @@
 #pragma once
 
 #include "Bonus.h"
+#include "BonusCacheKey.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-class CSelector : std::function<bool(const Bonus*)>
+/// Predicate that selects bonuses. Stored as immutable expression tree, so combining selectors
+/// does not nest std::function calls and simple selectors can be inspected (type filtering, caching)
+class DLL_LINKAGE CSelector
 {
-	using TBase = std::function<bool(const Bonus*)>;
+	using TFunction = std::function<bool(const Bonus*)>;
+
+	enum class EOperation : uint8_t
+	{
+		ALL,
+		NONE,
+		AND,
+		OR,
+		NOT,
+		TYPE,
+		SUBTYPE,
+		INFO,
+		SOURCE,
+		SOURCE_ID,
+		TARGET_SOURCE,
+		VALUE_TYPE,
+		EFFECT_RANGE,
+		WILL_LAST_TURNS,
+		WILL_LAST_DAYS,
+		FUNCTION
+	};
+
+	struct Instruction
+	{
+		EOperation operation;
+		uint32_t length; // number of instructions in this subexpression, including this one
+		int32_t value; // value to compare against, or index in one of side tables of program
+	};
+
+	struct Program
+	{
+		std::vector<Instruction> instructions; // expression tree in prefix order
+		std::vector<BonusSubtypeID> subtypes;
+		std::vector<BonusSourceID> sourceIDs;
+		std::vector<CAddInfo> infos;
+		std::vector<TFunction> functions;
+
+		std::optional<BonusType> requiredType;
+		BonusCacheKey cacheKey;
+
+		void append(const Program & other, size_t begin, size_t end);
+		void finalize();
+		std::optional<BonusType> getRequiredType(size_t index) const;
+		bool evaluate(size_t index, const Bonus * b) const;
+	};
+
+	std::shared_ptr<const Program> program;
+
+	static CSelector fromProgram(std::shared_ptr<const Program> program);
+	static CSelector leaf(EOperation operation, int32_t value);
+	static CSelector fromFunction(TFunction function);
+	CSelector combine(EOperation operation, const CSelector & rhs) const;
+	bool isOperation(EOperation operation) const;
+
 public:
 	CSelector() = default;
 	template<typename T>
 	CSelector(const T &t,	//SFINAE trick -> include this c-tor in overload resolution only if parameter is class
 							//(includes functors, lambdas) or function. Without that VC is going mad about ambiguities.
 		typename std::enable_if_t < std::is_class_v<T> || std::is_function_v<T> > *dummy = nullptr)
-		: TBase(t)
+		: CSelector(fromFunction(t))
 	{}
 
 	CSelector(std::nullptr_t)
 	{}
 
-	CSelector And(CSelector rhs) const
-	{
-		//lambda may likely outlive "this" (it can be even a temporary) => we copy the OBJECT (not pointer)
-		auto thisCopy = *this;
-		return [thisCopy, rhs](const Bonus *b) mutable { return thisCopy(b) && rhs(b); };
-	}
-	CSelector Or(CSelector rhs) const
-	{
-		auto thisCopy = *this;
-		return [thisCopy, rhs](const Bonus *b) mutable { return thisCopy(b) || rhs(b); };
-	}
+	CSelector And(CSelector rhs) const;
+	CSelector Or(CSelector rhs) const;
+	CSelector Not() const;
 
-	CSelector Not() const
+	bool operator()(const Bonus *b) const
 	{
-		auto thisCopy = *this;
-		return [thisCopy](const Bonus *b) mutable { return !thisCopy(b); };
+		if(!program)
+			throw std::bad_function_call();
+		return program->evaluate(0, b);
 	}
 
-	bool operator()(const Bonus *b) const
+	operator bool() const
 	{
-		return TBase::operator()(b);
+		return program != nullptr;
 	}
 
-	operator bool() const
+	/// Returns true if this selector accepts any bonus
+	bool isAll() const;
+	/// Returns type that all bonuses accepted by this selector have, if there is such type
+	std::optional<BonusType> getRequiredType() const;
+	/// Returns key that describes this selector exactly, or empty key if selector is too complex
+	BonusCacheKey getCacheKey() const;
+
+	/// Selectors that compare field of bonus against value. Known fields are compiled into expression tree
+	template<typename T>
+	static CSelector fieldEqual(T Bonus::*field, const T & value)
 	{
-		return !!static_cast<const TBase&>(*this);
+		return fromFunction([field, value](const Bonus *bonus)
+		{
+			return bonus->*field == value;
+		});
 	}
+	static CSelector fieldEqual(BonusType Bonus::*field, const BonusType & value);
+	static CSelector fieldEqual(BonusSubtypeID Bonus::*field, const BonusSubtypeID & value);
+	static CSelector fieldEqual(CAddInfo Bonus::*field, const CAddInfo & value);
+	static CSelector fieldEqual(BonusSource Bonus::*field, const BonusSource & value);
+	static CSelector fieldEqual(BonusSourceID Bonus::*field, const BonusSourceID & value);
+	static CSelector fieldEqual(BonusValueType Bonus::*field, const BonusValueType & value);
+	static CSelector fieldEqual(BonusLimitEffect Bonus::*field, const BonusLimitEffect & value);
+
+	static CSelector willLastTurns(int turns);
+	static CSelector willLastDays(int days);
+	static CSelector constant(bool value);
 };
 
 template<typename T>
@@ -71,11 +143,7 @@ public:
 
 	CSelector operator()(const T &valueToCompareAgainst) const
 	{
-		auto ptr2 = ptr; //We need a COPY because we don't want to reference this (might be outlived by lambda)
-		return [ptr2, valueToCompareAgainst](const Bonus *bonus)
-		{
-			return bonus->*ptr2 == valueToCompareAgainst;
-		};
+		return CSelector::fieldEqual(ptr, valueToCompareAgainst);
 	}
 };
 
@@ -127,8 +195,8 @@ namespace Selector
 	extern DLL_LINKAGE const CSelectFieldEqual<BonusSource> & sourceType();
 	extern DLL_LINKAGE const CSelectFieldEqual<BonusSource> & targetSourceType();
 	extern DLL_LINKAGE const CSelectFieldEqual<BonusLimitEffect> & effectRange();
-	CWillLastTurns DLL_LINKAGE turns(int turns);
-	CWillLastDays DLL_LINKAGE days(int days);
+	CSelector DLL_LINKAGE turns(int turns);
+	CSelector DLL_LINKAGE days(int days);
 
 	CSelector DLL_LINKAGE typeSubtype(BonusType Type, BonusSubtypeID Subtype);
 	CSelector DLL_LINKAGE typeSubtypeInfo(BonusType type, BonusSubtypeID subtype, const CAddInfo & info);
@@ -18,6 +18,7 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 std::atomic<int64_t> CBonusSystemNode::treeChanged(1);
+std::atomic<int64_t> CBonusSystemNode::lastVersion(1);
 constexpr bool CBonusSystemNode::cachingEnabled = true;
 
 std::shared_ptr<Bonus> CBonusSystemNode::getLocalBonus(const CSelector & selector)
@@ -107,50 +108,37 @@ void CBonusSystemNode::getAllBonusesRec(BonusList &out, const CSelector & select
 	}
 }
 
-TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, const CSelector &limit, const std::string &cachingStr) const
+TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey) const
 {
 	if (CBonusSystemNode::cachingEnabled)
 	{
-		// Exclusive access for one thread
-		boost::lock_guard<boost::mutex> lock(sync);
-
-		// If the bonus system tree changes(state of a single node or the relations to each other) then
+		// If this node or any of its ancestors changes (state of a single node or the relations to each other) then
 		// cache all bonus objects. Selector objects doesn't matter.
-		if (cachedLast != treeChanged)
-		{
-			BonusList allBonuses;
-			allBonuses.reserve(cachedBonuses.capacity()); //we assume we'll get about the same number of bonuses
-
-			cachedBonuses.clear();
-			cachedRequests.clear();
-
-			getAllBonusesRec(allBonuses, Selector::all);
-			limitBonuses(allBonuses, cachedBonuses);
-			cachedBonuses.stackBonuses();
+		auto currentCache = getBonusCache(getTreeVersion());
 
-			cachedLast = treeChanged;
-		}
+		// Simple selectors describe themselves, so their results can be cached even without explicit key
+		const BonusCacheKey requestKey = cachingKey.empty() && (!limit || limit.isAll()) ? selector.getCacheKey() : cachingKey;
 
-		// If a bonus system request comes with a caching string then look up in the map if there are any
+		// If a bonus system request comes with a caching key then look up in the table if there are any
 		// pre-calculated bonus results. Limiters can't be cached so they have to be calculated.
-		if(!cachingStr.empty())
+		if(!requestKey.empty())
 		{
-			auto it = cachedRequests.find(cachingStr);
-			if(it != cachedRequests.end())
+			auto cachedResult = currentCache->findRequest(requestKey);
+			if(cachedResult)
 			{
 				//Cached list contains bonuses for our query with applied limiters
-				return it->second;
+				return cachedResult;
 			}
 		}
 
 		//We still don't have the bonuses (didn't returned them from cache)
 		//Perform bonus selection
 		auto ret = std::make_shared<BonusList>();
-		cachedBonuses.getBonuses(*ret, selector, limit);
+		currentCache->bonuses->getBonuses(*ret, selector, limit);
 
 		// Save the results in the cache
-		if(!cachingStr.empty())
-			cachedRequests[cachingStr] = ret;
+		if(!requestKey.empty())
+			currentCache->addRequest(requestKey, ret);
 
 		return ret;
 	}
@@ -160,6 +148,106 @@ TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, co
 	}
 }
 
+std::shared_ptr<const CBonusSystemNode::BonusCache> CBonusSystemNode::getBonusCache(int64_t version) const
+{
+	// Fast path - cache is up to date, node mutex is not needed
+	auto currentCache = std::atomic_load(&cache);
+	if(currentCache && currentCache->version == version)
+		return currentCache;
+
+	// Exclusive access for one thread
+	boost::lock_guard<boost::mutex> lock(sync);
+
+	// Another thread might have already rebuilt the cache while we were waiting
+	currentCache = std::atomic_load(&cache);
+	if(currentCache && currentCache->version == version)
+		return currentCache;
+
+	BonusList allBonuses;
+	auto limitedBonuses = std::make_shared<BonusList>();
+	if(currentCache)
+		allBonuses.reserve(currentCache->bonuses->size()); //we assume we'll get about the same number of bonuses
+
+	getAllBonusesRec(allBonuses, Selector::all);
+	limitBonuses(allBonuses, *limitedBonuses);
+	limitedBonuses->stackBonuses();
+	limitedBonuses->enableTypeIndex();
+
+	auto newCache = std::make_shared<BonusCache>();
+	newCache->version = version;
+	newCache->bonuses = limitedBonuses;
+
+	std::atomic_store(&cache, std::shared_ptr<const BonusCache>(newCache));
+	return newCache;
+}
+
+CBonusSystemNode::BonusCache::BonusCache()
+{
+	// most nodes receive only few distinct requests, so they never need to grow the table
+	requests = &requestTables.emplace_back(16);
+}
+
+CBonusSystemNode::BonusCache::RequestTable::RequestTable(size_t size):
+	slots(size)
+{
+}
+
+TConstBonusListPtr CBonusSystemNode::BonusCache::findRequest(const BonusCacheKey & key) const
+{
+	// Slots are never modified after being published, so readers don't need requestsMutex
+	const RequestTable * table = requests.load(std::memory_order_acquire);
+
+	const size_t mask = table->slots.size() - 1;
+	for(size_t index = key.hash() & mask;; index = (index + 1) & mask)
+	{
+		const CachedRequest * entry = table->slots[index].load(std::memory_order_acquire);
+		if(!entry)
+			return nullptr;
+		if(entry->key == key)
+			return entry->result;
+	}
+}
+
+void CBonusSystemNode::BonusCache::addRequest(const BonusCacheKey & key, const TConstBonusListPtr & result) const
+{
+	assert(!key.empty());
+
+	// Adding request to an outdated snapshot is harmless - it will be discarded together with the snapshot
+	boost::lock_guard<boost::mutex> lock(requestsMutex);
+
+	// Another thread might have already cached the same request
+	if(findRequest(key))
+		return;
+
+	requestEntries.push_back({key, result});
+	RequestTable * table = requests.load(std::memory_order_relaxed);
+
+	// keep load factor below 1/2 so probing sequences stay short and always reach an empty slot
+	if(requestEntries.size() * 2 > table->slots.size())
+	{
+		// Only growth copies the table. Readers that still probe the outgrown table find all its entries there
+		RequestTable & grownTable = requestTables.emplace_back(table->slots.size() * 2);
+		for(const auto & cachedRequest : requestEntries)
+			insertRequest(grownTable, cachedRequest);
+
+		requests.store(&grownTable, std::memory_order_release);
+	}
+	else
+	{
+		insertRequest(*table, requestEntries.back());
+	}
+}
+
+void CBonusSystemNode::BonusCache::insertRequest(RequestTable & table, const CachedRequest & entry)
+{
+	const size_t mask = table.slots.size() - 1;
+	size_t index = entry.key.hash() & mask;
+	while(table.slots[index].load(std::memory_order_relaxed))
+		index = (index + 1) & mask;
+
+	table.slots[index].store(&entry, std::memory_order_release);
+}
+
 TConstBonusListPtr CBonusSystemNode::getAllBonusesWithoutCaching(const CSelector &selector, const CSelector &limit) const
 {
 	auto ret = std::make_shared<BonusList>();
@@ -181,19 +269,19 @@ std::shared_ptr<Bonus> CBonusSystemNode::getUpdatedBonus(const std::shared_ptr<B
 }
 
 CBonusSystemNode::CBonusSystemNode(bool isHypotetic):
-	bonuses(true),
-	exportedBonuses(true),
+	bonuses(this),
+	exportedBonuses(this),
 	nodeType(UNKNOWN),
-	cachedLast(0),
+	nodeChanged(++lastVersion),
 	isHypotheticNode(isHypotetic)
 {
 }
 
 CBonusSystemNode::CBonusSystemNode(ENodeTypes NodeType):
-	bonuses(true),
-	exportedBonuses(true),
+	bonuses(this),
+	exportedBonuses(this),
 	nodeType(NodeType),
-	cachedLast(0),
+	nodeChanged(++lastVersion),
 	isHypotheticNode(false)
 {
 }
@@ -207,6 +295,15 @@ CBonusSystemNode::~CBonusSystemNode()
 		while(!children.empty())
 			children.front()->detachFrom(*this);
 	}
+
+	// nodes attached only as source or hypothetic nodes are not detached above - drop dangling references to us
+	boost::lock_guard<boost::mutex> lock(inheritingChildrenMutex);
+	for(auto * child : inheritingChildren)
+	{
+		child->parentsToInherit -= this;
+		child->parentsToPropagate -= this;
+		child->nodeHasChanged();
+	}
 }
 
 void CBonusSystemNode::attachTo(CBonusSystemNode & parent)
@@ -224,13 +321,17 @@ void CBonusSystemNode::attachTo(CBonusSystemNode & parent)
 		parent.newChildAttached(*this);
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::attachToSource(const CBonusSystemNode & parent)
 {
 	assert(!vstd::contains(parentsToInherit, &parent));
 	parentsToInherit.push_back(&parent);
+	{
+		boost::lock_guard<boost::mutex> lock(parent.inheritingChildrenMutex);
+		parent.inheritingChildren.push_back(this);
+	}
 
 	if(!isHypothetic())
 	{
@@ -238,7 +339,7 @@ void CBonusSystemNode::attachToSource(const CBonusSystemNode & parent)
 			parent.newRedDescendant(*this);
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::detachFrom(CBonusSystemNode & parent)
@@ -267,7 +368,7 @@ void CBonusSystemNode::detachFrom(CBonusSystemNode & parent)
 	{
 		parent.childDetached(*this);
 	}
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 
@@ -284,6 +385,9 @@ void CBonusSystemNode::detachFromSource(const CBonusSystemNode & parent)
 	if (vstd::contains(parentsToInherit, &parent))
 	{
 		parentsToInherit -= &parent;
+
+		boost::lock_guard<boost::mutex> lock(parent.inheritingChildrenMutex);
+		parent.inheritingChildren -= this;
 	}
 	else
 	{
@@ -291,7 +395,7 @@ void CBonusSystemNode::detachFromSource(const CBonusSystemNode & parent)
 			, nodeShortInfo(), nodeType, parent.nodeShortInfo(), parent.nodeType);
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::removeBonusesRecursive(const CSelector & s)
@@ -327,14 +431,17 @@ void CBonusSystemNode::addNewBonus(const std::shared_ptr<Bonus>& b)
 	assert(!vstd::contains(exportedBonuses, b));
 	exportedBonuses.push_back(b);
 	exportBonus(b);
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::accumulateBonus(const std::shared_ptr<Bonus>& b)
 {
 	auto bonus = exportedBonuses.getFirst(Selector::typeSubtypeValueType(b->type, b->subtype, b->valType)); //only local bonuses are interesting
 	if(bonus)
+	{
 		bonus->val += b->val;
+		nodeHasChanged();
+	}
 	else
 		addNewBonus(std::make_shared<Bonus>(*b)); //duplicate needed, original may get destroyed
 }
@@ -346,7 +453,7 @@ void CBonusSystemNode::removeBonus(const std::shared_ptr<Bonus>& b)
 		unpropagateBonus(b);
 	else
 		bonuses -= b;
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::removeBonuses(const CSelector & selector)
@@ -396,11 +503,11 @@ void CBonusSystemNode::unpropagateBonus(const std::shared_ptr<Bonus> & b)
 		else
 			logBonus->warn("Attempt to remove #$# %s, which is not propagated to %s", b->Description(), nodeName());
 
-		bonuses.remove_if([b](const auto & bonus)
+		bonuses.remove_if([this, b](const auto & bonus)
 		{
 			if (bonus->propagationUpdater && bonus->propagationUpdater == b->propagationUpdater)
 			{
-				treeHasChanged();
+				nodeHasChanged();
 				return true;
 			}
 			return false;
@@ -556,7 +663,7 @@ void CBonusSystemNode::exportBonus(const std::shared_ptr<Bonus> & b)
 	else
 		bonuses.push_back(b);
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::exportBonuses()
@@ -627,12 +734,30 @@ void CBonusSystemNode::limitBonuses(const BonusList &allBonuses, BonusList &out)
 
 void CBonusSystemNode::treeHasChanged()
 {
-	treeChanged++;
+	treeChanged = ++lastVersion;
+}
+
+void CBonusSystemNode::nodeHasChanged() const
+{
+	invalidateSubtree(++lastVersion);
+}
+
+void CBonusSystemNode::invalidateSubtree(int64_t version) const
+{
+	// node reachable through several paths was already visited during this invalidation
+	if(nodeChanged == version)
+		return;
+
+	nodeChanged = version;
+
+	boost::lock_guard<boost::mutex> lock(inheritingChildrenMutex);
+	for(const auto * child : inheritingChildren)
+		child->invalidateSubtree(version);
 }
 
 int64_t CBonusSystemNode::getTreeVersion() const
 {
-	return treeChanged;
+	return std::max(nodeChanged.load(), treeChanged.load());
 }
 
 VCMI_LIB_NAMESPACE_END
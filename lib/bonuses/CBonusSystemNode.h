@@ -37,23 +37,59 @@ private:
 	TCNodesVector parentsToInherit; // we inherit bonuses from them
 	TNodesVector parentsToPropagate; // we may attach our bonuses to them
 	TNodesVector children;
+	mutable TNodesVector inheritingChildren; // nodes that inherit bonuses from us, including source-only and hypothetic ones
+	mutable boost::mutex inheritingChildrenMutex; // shared nodes, such as creatures, may get hypothetic children from multiple threads
 
 	ENodeTypes nodeType;
 	bool isHypotheticNode;
 
+	/// Snapshot of bonus cache. Published atomically, so readers that find it up to date never take node mutex
+	struct BonusCache
+	{
+		BonusCache();
+
+		int64_t version = 0;
+		std::shared_ptr<const BonusList> bonuses; // all bonuses of this node with limiters applied
+
+		// Passing a cachingKey when getting bonuses caches the result for later requests.
+		struct CachedRequest
+		{
+			BonusCacheKey key;
+			TConstBonusListPtr result;
+		};
+
+		// Open-addressing table with linear probing, size is always power of two
+		// Filled in place - each slot is published atomically once and never changed afterwards
+		struct RequestTable
+		{
+			explicit RequestTable(size_t size);
+
+			std::vector<std::atomic<const CachedRequest *>> slots;
+		};
+
+		mutable std::atomic<RequestTable *> requests; // current table, replaced only when it grows
+		mutable std::deque<RequestTable> requestTables; // current and outgrown tables, readers may still probe outgrown ones
+		mutable std::deque<CachedRequest> requestEntries; // all cached requests, never moved once added
+		mutable boost::mutex requestsMutex; // taken only by writers of requests
+
+		TConstBonusListPtr findRequest(const BonusCacheKey & key) const;
+		void addRequest(const BonusCacheKey & key, const TConstBonusListPtr & result) const;
+
+	private:
+		static void insertRequest(RequestTable & table, const CachedRequest & entry);
+	};
+
 	static const bool cachingEnabled;
-	mutable BonusList cachedBonuses;
-	mutable int64_t cachedLast;
-	static std::atomic<int64_t> treeChanged;
+	mutable std::shared_ptr<const BonusCache> cache; // accessed only via std::atomic_load / std::atomic_store
+	mutable std::atomic<int64_t> nodeChanged; // version of last change of this node or any of its ancestors
+	static std::atomic<int64_t> treeChanged; // version of last change that may affect any node
+	static std::atomic<int64_t> lastVersion; // source of unique, monotonic versions
 
-	// Setting a value to cachingStr before getting any bonuses caches the result for later requests.
-	// This string needs to be unique, that's why it has to be set in the following manner:
-	// [property key]_[value] => only for selector
-	mutable std::map<std::string, TBonusListPtr > cachedRequests;
-	mutable boost::mutex sync;
+	mutable boost::mutex sync; // taken only by writers of cache
 
 	void getAllBonusesRec(BonusList &out, const CSelector & selector) const;
 	TConstBonusListPtr getAllBonusesWithoutCaching(const CSelector &selector, const CSelector &limit) const;
+	std::shared_ptr<const BonusCache> getBonusCache(int64_t version) const;
 	std::shared_ptr<Bonus> getUpdatedBonus(const std::shared_ptr<Bonus> & b, const TUpdaterPtr & updater) const;
 	void limitBonuses(const BonusList &allBonuses, BonusList &out) const; //out will bo populed with bonuses that are not limited here
 
@@ -62,6 +98,7 @@ private:
 	void getRedChildren(TNodes &out);
 
 	void getAllParents(TCNodes & out) const;
+	void invalidateSubtree(int64_t version) const;
 
 	void newChildAttached(CBonusSystemNode & child);
 	void childDetached(CBonusSystemNode & child);
@@ -85,7 +122,7 @@ public:
 	explicit CBonusSystemNode(ENodeTypes NodeType);
 	virtual ~CBonusSystemNode();
 
-	TConstBonusListPtr getAllBonuses(const CSelector &selector, const CSelector &limit, const std::string &cachingStr = "") const override;
+	TConstBonusListPtr getAllBonuses(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey = {}) const override;
 	void getParents(TCNodes &out) const;  //retrieves list of parent nodes (nodes to inherit bonuses from),
 
 	/// Returns first bonus matching selector
@@ -120,7 +157,10 @@ public:
 	void setNodeType(CBonusSystemNode::ENodeTypes type);
 	const TCNodesVector & getParentNodes() const;
 
+	/// Invalidates caches of all nodes. Use when it is unknown which nodes are affected by a change
 	static void treeHasChanged();
+	/// Invalidates caches of this node and of all nodes that inherit bonuses from it
+	void nodeHasChanged() const;
 
 	int64_t getTreeVersion() const override;
 
@@ -15,76 +15,68 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-int IBonusBearer::valOfBonuses(const CSelector &selector, const std::string &cachingStr) const
+int IBonusBearer::valOfBonuses(const CSelector &selector, const BonusCacheKey &cachingKey) const
 {
-	TConstBonusListPtr hlp = getAllBonuses(selector, nullptr, cachingStr);
+	TConstBonusListPtr hlp = getAllBonuses(selector, nullptr, cachingKey);
 	return hlp->totalValue();
 }
 
-bool IBonusBearer::hasBonus(const CSelector &selector, const std::string &cachingStr) const
+bool IBonusBearer::hasBonus(const CSelector &selector, const BonusCacheKey &cachingKey) const
 {
 	//TODO: We don't need to count all bonuses and could break on first matching
-	return !getBonuses(selector, cachingStr)->empty();
+	return !getBonuses(selector, cachingKey)->empty();
 }
 
-bool IBonusBearer::hasBonus(const CSelector &selector, const CSelector &limit, const std::string &cachingStr) const
+bool IBonusBearer::hasBonus(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey) const
 {
-	return !getBonuses(selector, limit, cachingStr)->empty();
+	return !getBonuses(selector, limit, cachingKey)->empty();
 }
 
-TConstBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const std::string &cachingStr) const
+TConstBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const BonusCacheKey &cachingKey) const
 {
-	return getAllBonuses(selector, nullptr, cachingStr);
+	return getAllBonuses(selector, nullptr, cachingKey);
 }
 
-TConstBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const CSelector &limit, const std::string &cachingStr) const
+TConstBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey) const
 {
-	return getAllBonuses(selector, limit, cachingStr);
+	return getAllBonuses(selector, limit, cachingKey);
 }
 
 int IBonusBearer::valOfBonuses(BonusType type) const
 {
 	//This part is performance-critical
-	std::string cachingStr = "type_" + std::to_string(static_cast<int>(type));
-
 	CSelector s = Selector::type()(type);
 
-	return valOfBonuses(s, cachingStr);
+	return valOfBonuses(s, BonusCacheKey::type(type));
 }
 
 bool IBonusBearer::hasBonusOfType(BonusType type) const
 {
 	//This part is performance-critical
-	std::string cachingStr = "type_" + std::to_string(static_cast<int>(type));
-
 	CSelector s = Selector::type()(type);
 
-	return hasBonus(s, cachingStr);
+	return hasBonus(s, BonusCacheKey::type(type));
 }
 
 int IBonusBearer::valOfBonuses(BonusType type, BonusSubtypeID subtype) const
 {
 	//This part is performance-critical
-	std::string cachingStr = "type_" + std::to_string(static_cast<int>(type)) + "_" + subtype.toString();
-
 	CSelector s = Selector::typeSubtype(type, subtype);
 
-	return valOfBonuses(s, cachingStr);
+	return valOfBonuses(s, BonusCacheKey::typeSubtype(type, subtype));
 }
 
 bool IBonusBearer::hasBonusOfType(BonusType type, BonusSubtypeID subtype) const
 {
 	//This part is performance-critical
-	std::string cachingStr = "type_" + std::to_string(static_cast<int>(type)) + "_" + subtype.toString();
-
 	CSelector s = Selector::typeSubtype(type, subtype);
 
-	return hasBonus(s, cachingStr);
+	return hasBonus(s, BonusCacheKey::typeSubtype(type, subtype));
 }
 
 bool IBonusBearer::hasBonusFrom(BonusSource source, BonusSourceID sourceID) const
 {
-	return hasBonus(Selector::source(source,sourceID));
+	return hasBonus(Selector::source(source,sourceID), BonusCacheKey::source(source, sourceID));
 }
 
 std::shared_ptr<const Bonus> IBonusBearer::getBonus(const CSelector &selector) const
@@ -36,6 +36,12 @@ public:
 		return result;
 	}
 
+	/// Returns index of identifier type that is currently stored in this variant
+	size_t getTypeIndex() const
+	{
+		return value.index();
+	}
+
 	std::string toString() const
 	{
 		std::string result;
@@ -134,7 +134,8 @@ si64 CCompressedStream::readMore(ui8 *data, si64 size)
 
 	do
 	{
-		if (inflateState->avail_in == 0)
+		// on truncated input inflate will report Z_BUF_ERROR once there is nothing left to read
+		if (inflateState->avail_in == 0 && gzipStream != nullptr)
 		{
 			//inflate ran out of available data or was not initialized yet
 			// get new input data and update state accordingly
@@ -48,6 +48,7 @@
 #include "../modding/ModScope.h"
 #include "../networkPacks/NetPacksBase.h"
 #include "../pathfinder/CPathfinder.h"
+#include "../pathfinder/NodeStorage.h"
 #include "../pathfinder/PathfinderOptions.h"
 #include "../rmg/CMapGenerator.h"
 #include "../serializer/CMemorySerializer.h"
@@ -55,6 +56,8 @@
 
 #include <vstd/RNG.h>
 
+#include "tbb/parallel_for.h"
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 boost::shared_mutex CGameState::mutex;
@@ -1156,6 +1159,40 @@ void CGameState::calculatePaths(const std::shared_ptr<PathfinderConfig> & config
 	pathfinder.calculatePaths();
 }
 
+void CGameState::calculatePaths(const std::vector<CPathsInfo *> & out)
+{
+	if(out.empty())
+		return;
+
+	const PlayerColor player = out.front()->hero->tempOwner;
+
+	// Evaluating air layer covers every tile of the map, skip it if no hero in this batch can fly
+	// Ask the same helper that pathfinder uses. Layers available on first turn are superset of later turns,
+	// since bonuses of hero may only expire with time
+	const PathfinderOptions options(this);
+	bool includeAir = false;
+	for(const auto * paths : out)
+	{
+		CPathfinderHelper helper(this, paths->hero, options);
+		if(helper.isLayerAvailable(EPathfindingLayer::AIR))
+		{
+			includeAir = true;
+			break;
+		}
+	}
+
+	auto accessibility = std::make_shared<const PlayerTileAccessibility>(this, player, includeAir);
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, out.size()), [&](const tbb::blocked_range<size_t> & range)
+	{
+		for(size_t i = range.begin(); i != range.end(); ++i)
+		{
+			assert(out[i]->hero->tempOwner == player);
+			calculatePaths(std::make_shared<SingleHeroPathfinderConfig>(*out[i], this, out[i]->hero, accessibility));
+		}
+	});
+}
+
 /**
  * Tells if the tile is guarded by a monster as well as the position
  * of the monster that will attack on it.
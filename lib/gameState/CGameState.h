@@ -106,6 +106,9 @@ public:
 	bool checkForVisitableDir(const int3 & src, const int3 & dst) const; //check if src tile is visitable from dst tile
 	void calculatePaths(const CGHeroInstance *hero, CPathsInfo &out) override; //calculates possible paths for hero, by default uses current hero position and movement left; returns pointer to newly allocated CPath or nullptr if path does not exists
 	void calculatePaths(const std::shared_ptr<PathfinderConfig> & config) override;
+	/// calculates paths for multiple heroes of the same player at once, out must be already initialized with these heroes
+	/// accessibility of tiles is evaluated only once for all heroes and pathfinding of each hero runs in parallel
+	void calculatePaths(const std::vector<CPathsInfo *> & out) override;
 	int3 guardingCreaturePosition (int3 pos) const override;
 	std::vector<CGObjectInstance*> guardingCreatures (int3 pos) const;
 
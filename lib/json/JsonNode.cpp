@@ -142,9 +142,31 @@ JsonNode::JsonType JsonNode::getType() const
 	return static_cast<JsonType>(data.index());
 }
 
+/// Same mod scope is used by all nodes loaded from the mod, so every scope is stored only once
+static const std::string * internModScope(const std::string & scope)
+{
+	if(scope.empty())
+		return nullptr;
+
+	// consecutive nodes almost always come from the same mod, so lookup in shared set can be skipped for them
+	// interned strings are never removed, so pointer stays valid
+	static thread_local const std::string * lastScope = nullptr;
+	if(lastScope && *lastScope == scope)
+		return lastScope;
+
+	static std::unordered_set<std::string> knownScopes;
+	// json data may be loaded by multiple threads at once
+	static std::mutex knownScopesMutex;
+	TLockGuard lock(knownScopesMutex);
+
+	lastScope = &*knownScopes.insert(scope).first;
+	return lastScope;
+}
+
 const std::string & JsonNode::getModScope() const
 {
-	return modScope;
+	static const std::string emptyScope;
+	return modScope ? *modScope : emptyScope;
 }
 
 void JsonNode::setOverrideFlag(bool value)
@@ -159,7 +181,15 @@ bool JsonNode::getOverrideFlag() const
 
 void JsonNode::setModScope(const std::string & metadata, bool recursive)
 {
-	modScope = metadata;
+	if(modScope && *modScope == metadata)
+		setInternedModScope(modScope, recursive);
+	else
+		setInternedModScope(internModScope(metadata), recursive);
+}
+
+void JsonNode::setInternedModScope(const std::string * internedScope, bool recursive)
+{
+	modScope = internedScope;
 	if(recursive)
 	{
 		switch(getType())
@@ -169,7 +199,7 @@ void JsonNode::setModScope(const std::string & metadata, bool recursive)
 			{
 				for(auto & node : Vector())
 				{
-					node.setModScope(metadata);
+					node.setInternedModScope(internedScope, true);
 				}
 			}
 			break;
@@ -177,7 +207,7 @@ void JsonNode::setModScope(const std::string & metadata, bool recursive)
 			{
 				for(auto & node : Struct())
 				{
-					node.second.setModScope(metadata);
+					node.second.setInternedModScope(internedScope, true);
 				}
 			}
 		}
@@ -55,10 +55,13 @@ private:
 	JsonData data;
 
 	/// Mod-origin of this particular field
-	std::string modScope;
+	/// Points to interned string shared by all nodes with the same origin, or null if origin is not known
+	const std::string * modScope = nullptr;
 
 	bool overrideFlag = false;
 
+	void setInternedModScope(const std::string * internedScope, bool recursive);
+
 public:
 	JsonNode() = default;
 
@@ -151,7 +154,10 @@ public:
 	template<typename Handler>
 	void serialize(Handler & h)
 	{
-		h & modScope;
+		std::string scope = getModScope();
+		h & scope;
+		if(!h.saving)
+			setModScope(scope, false);
 		h & overrideFlag;
 		h & data;
 	}
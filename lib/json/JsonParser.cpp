@@ -15,8 +15,79 @@
 #include "../texts/TextOperations.h"
 #include "JsonFormatException.h"
 
+#include <boost/endian/conversion.hpp>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
+namespace
+{
+
+// Helpers for scanning of input by 8 characters at once, using only integer operations ("SIMD within a register")
+// Masks returned by these functions have highest bit set in every matching byte, and only in it
+using TWord = uint64_t;
+
+constexpr TWord repeatByte(uint8_t value)
+{
+	return 0x0101010101010101ull * value;
+}
+
+constexpr TWord highBits = repeatByte(0x80);
+constexpr TWord lowBits = repeatByte(0x7F);
+
+/// Loads 8 characters, with first character in lowest byte on any platform
+TWord loadWord(const char * data)
+{
+	TWord word;
+	std::memcpy(&word, data, sizeof(word));
+	return boost::endian::native_to_little(word);
+}
+
+TWord bytesEqual(TWord word, uint8_t value)
+{
+	TWord difference = word ^ repeatByte(value);
+	return ~(((difference & lowBits) + lowBits) | difference | lowBits);
+}
+
+/// Value must not be larger than 0x80
+TWord bytesLess(TWord word, uint8_t value)
+{
+	return ~(((word & lowBits) + repeatByte(0x80 - value)) | word) & highBits;
+}
+
+/// Returns index of first matching byte in non-empty mask
+size_t firstByte(TWord mask)
+{
+	size_t index = 0;
+	while(!(mask & 0x80))
+	{
+		mask >>= 8;
+		index++;
+	}
+	return index;
+}
+
+/// Returns position of first character starting from 'pos' that is selected by mask function, or size of input if there is none
+template<typename MaskFunction>
+size_t findFirst(std::string_view input, size_t pos, const MaskFunction & selected)
+{
+	for(; pos + sizeof(TWord) <= input.size(); pos += sizeof(TWord))
+	{
+		TWord mask = selected(loadWord(input.data() + pos));
+		if(mask)
+			return pos + firstByte(mask);
+	}
+
+	// remaining characters are checked one by one by placing them into lowest byte of word
+	for(; pos < input.size(); pos++)
+	{
+		if(selected(static_cast<uint8_t>(input[pos])) & 0x80)
+			return pos;
+	}
+	return input.size();
+}
+
+}
+
 JsonParser::JsonParser(const std::byte * inputString, size_t stringSize, const JsonParsingSettings & settings)
 	: settings(settings)
 	, input(reinterpret_cast<const char *>(inputString), stringSize)
@@ -118,6 +189,30 @@ bool JsonParser::extractWhitespace(bool verbose)
 
 	while(true)
 	{
+		// skip whitespaces by 8 characters at once, counting new lines only in words that have them
+		while(pos + sizeof(TWord) <= input.size())
+		{
+			TWord word = loadWord(input.data() + pos);
+			TWord whitespaces = bytesLess(word, ' ' + 1);
+			size_t whitespacesCount = whitespaces == highBits ? sizeof(TWord) : firstByte(~whitespaces & highBits);
+
+			if(bytesEqual(word, '\n'))
+			{
+				for(size_t i = pos; i < pos + whitespacesCount; i++)
+				{
+					if(input[i] == '\n')
+					{
+						lineCount++;
+						lineStart = i + 1;
+					}
+				}
+			}
+
+			pos += whitespacesCount;
+			if(whitespacesCount != sizeof(TWord))
+				break;
+		}
+
 		while(pos < input.size() && static_cast<ui8>(input[pos]) <= ' ')
 		{
 			if(input[pos] == '\n')
@@ -142,8 +237,10 @@ bool JsonParser::extractWhitespace(bool verbose)
 		else
 			error("Comments must consist of two slashes!", true);
 
-		while(pos < input.size() && input[pos] != '\n')
-			pos++;
+		pos = findFirst(input, pos, [](TWord word)
+		{
+			return bytesEqual(word, '\n');
+		});
 	}
 
 	if(pos >= input.size() && verbose)
@@ -208,8 +305,19 @@ bool JsonParser::extractString(std::string & str)
 
 	size_t first = pos;
 
+	// characters that end string or need special handling
+	auto specialCharacters = [lineTerminator](TWord word)
+	{
+		return bytesEqual(word, lineTerminator) | bytesEqual(word, '\\') | bytesLess(word, ' ');
+	};
+
 	while(pos != input.size())
 	{
+		// regular characters are copied as a single block once end of string or special character is found
+		pos = findFirst(input, pos, specialCharacters);
+		if(pos == input.size())
+			break;
+
 		if(input[pos] == lineTerminator) // Correct end of string
 		{
 			str.append(&input[first], pos - first);
@@ -248,12 +356,14 @@ bool JsonParser::extractString(JsonNode & node)
 		return false;
 
 	node.setType(JsonNode::JsonType::DATA_STRING);
-	node.String() = str;
+	node.String() = std::move(str);
 	return true;
 }
 
 bool JsonParser::extractLiteral(std::string & literal)
 {
+	size_t first = pos;
+
 	while(pos < input.size())
 	{
 		bool isUpperCase = input[pos] >= 'A' && input[pos] <= 'Z';
@@ -263,10 +373,10 @@ bool JsonParser::extractLiteral(std::string & literal)
 		if(!isUpperCase && !isLowerCase && !isNumber)
 			break;
 
-		literal += input[pos];
 		pos++;
 	}
 
+	literal.append(input.data() + first, pos - first);
 	return true;
 }
 
@@ -380,16 +490,17 @@ bool JsonParser::extractStruct(JsonNode & node)
 			}
 		}
 
-		if(node.Struct().find(key) != node.Struct().end())
+		auto [entry, inserted] = node.Struct().try_emplace(std::move(key));
+		if(!inserted)
 			error("Duplicate element encountered!", true);
 
 		if(!extractSeparator())
 			return false;
 
-		if(!extractElement(node.Struct()[key], '}'))
+		if(!extractElement(entry->second, '}'))
 			return false;
 
-		node.Struct()[key].setOverrideFlag(overrideFlag);
+		entry->second.setOverrideFlag(overrideFlag);
 
 		if(input[pos] == '}')
 		{
@@ -427,9 +538,7 @@ bool JsonParser::extractArray(JsonNode & node)
 	{
 		//NOTE: currently 50% of time is this vector resizing.
 		//May be useful to use list during parsing and then swap() all items to vector
-		node.Vector().resize(node.Vector().size() + 1);
-
-		if(!extractElement(node.Vector().back(), ']'))
+		if(!extractElement(node.Vector().emplace_back(), ']'))
 			return false;
 
 		if(input[pos] == ']')
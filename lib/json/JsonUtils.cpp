@@ -120,6 +120,9 @@ const JsonNode & getSchemaByName(const std::string & name)
 {
 	// cached schemas to avoid loading json data multiple times
 	static std::map<std::string, JsonNode> loadedSchemas;
+	// mod data may be validated by multiple threads at once
+	static std::mutex loadedSchemasMutex;
+	TLockGuard lock(loadedSchemasMutex);
 
 	if (vstd::contains(loadedSchemas, name))
 		return loadedSchemas[name];
@@ -272,7 +275,7 @@ JsonNode JsonUtils::assembleFromFiles(const std::vector<std::string> & files, bo
 			bool isValidFile = false;
 			JsonNode section(JsonPath::builtinTODO(file), isValidFile);
 			merge(result, section);
-			isValid |= isValidFile;
+			isValid &= isValidFile;
 		}
 		else
 		{
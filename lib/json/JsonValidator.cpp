@@ -72,9 +72,9 @@ static int getLevenshteinDistance(const std::string & s, const std::string & t)
 	return v0[n];
 }
 
-/// Searches for keys similar to 'target' in 'candidates' map
+/// Searches for keys similar to 'target' in 'candidates' list
 /// Returns closest match or empty string if no suitable candidates are found
-static std::string findClosestMatch(const JsonMap & candidates, const std::string & target)
+static std::string findClosestMatch(const std::vector<std::string> & candidates, const std::string & target)
 {
 	// Maximum distance at which we can consider strings to be similar
 	// If strings have more different symbols than this number then it is not a typo, but a completely different word
@@ -84,113 +84,197 @@ static std::string findClosestMatch(const JsonMap & candidates, const std::strin
 
 	for (auto const & candidate : candidates)
 	{
-		int newDistance = getLevenshteinDistance(candidate.first, target);
+		int newDistance = getLevenshteinDistance(candidate, target);
 
 		if (newDistance < bestDistance)
 		{
 			bestDistance = newDistance;
-			bestMatch = candidate.first;
+			bestMatch = candidate;
 		}
 	}
 	return bestMatch;
 }
 
-static std::string emptyCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+namespace
+{
+
+class JsonSchemaCompiler;
+
+/// Check of data against single field of schema. All information needed by check is extracted from schema during compilation
+using TCheck = std::function<std::string(JsonValidator &, const JsonNode &)>;
+
+/// Compiles field of schema into check. Returns empty check if field does not need to be checked
+using TFieldCompiler = std::function<TCheck(JsonSchemaCompiler &, const JsonNode &, const JsonNode &)>;
+using TCompilerMap = std::unordered_map<std::string, TFieldCompiler>;
+
+/// Schema compiled into list of checks, in the same order as fields are listed in schema
+class CompiledSchema
+{
+public:
+	struct Entry
+	{
+		TCheck check;
+		/// Bitmask of types of json data that this check applies to
+		uint8_t types;
+	};
+
+	std::vector<Entry> checks;
+
+	std::string check(JsonValidator & validator, const JsonNode & data) const
+	{
+		const uint8_t dataType = 1 << static_cast<int>(data.getType());
+		std::string errors;
+		for(const auto & entry : checks)
+		{
+			if (entry.types & dataType)
+				errors += entry.check(validator, data);
+		}
+		return errors;
+	}
+};
+
+/// Compiles schemas on first use and keeps them, so references between schemas are resolved only once
+class JsonSchemaCompiler
+{
+	/// Schemas compiled from URI. Entries are never removed, so schemas can keep pointers to each other
+	std::map<std::string, std::unique_ptr<CompiledSchema>> namedSchemas;
+	/// Schemas that are still being compiled, used to resolve recursive references
+	/// Moved to namedSchemas only once outermost compilation succeeds, since they may refer to each other
+	std::map<std::string, std::unique_ptr<CompiledSchema>> pendingSchemas;
+	std::vector<std::unique_ptr<CompiledSchema>> inlinedSchemas;
+
+	/// Stack of schemas that are being compiled. Last schema is the one used currently.
+	/// May contain multiple items in case if remote references were found
+	std::vector<std::string> usedSchemas;
+
+	static const TCompilerMap & getKnownFieldsFor(JsonNode::JsonType type);
+
+	void compileFields(CompiledSchema & result, const JsonNode & schema);
+
+public:
+	const CompiledSchema * compile(const std::string & URI);
+	const CompiledSchema * compile(const JsonNode & schema);
+
+	const std::string & currentSchemaName() const
+	{
+		return usedSchemas.back();
+	}
+};
+
+}
+
+static TCheck emptyCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
 	// check is not needed - e.g. incorporated into another check
-	return "";
+	return {};
 }
 
-static std::string notImplementedCheck(JsonValidator & validator,
-								const JsonNode & baseSchema,
-								const JsonNode & schema,
-								const JsonNode & data)
+static TCheck notImplementedCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	return "Not implemented entry in schema";
+	return [](JsonValidator & validator, const JsonNode & data) -> std::string
+	{
+		return "Not implemented entry in schema";
+	};
 }
 
-static std::string schemaListCheck(JsonValidator & validator,
-							const JsonNode & baseSchema,
+static TCheck schemaListCheck(JsonSchemaCompiler & compiler,
 							const JsonNode & schema,
-							const JsonNode & data,
 							const std::string & errorMsg,
-							const std::function<bool(size_t)> & isValid)
+							const std::function<bool(size_t, size_t)> & isValid)
 {
-	std::string errors = "<tested schemas>\n";
-	size_t result = 0;
-
+	std::vector<const CompiledSchema *> schemas;
 	for(const auto & schemaEntry : schema.Vector())
+		schemas.push_back(compiler.compile(schemaEntry));
+
+	return [schemas, errorMsg, isValid](JsonValidator & validator, const JsonNode & data)
 	{
-		std::string error = validator.check(schemaEntry, data);
-		if (error.empty())
+		std::string errors = "<tested schemas>\n";
+		size_t result = 0;
+
+		for(const auto * schemaEntry : schemas)
 		{
-			result++;
+			std::string error = schemaEntry->check(validator, data);
+			if (error.empty())
+			{
+				result++;
+			}
+			else
+			{
+				errors += error;
+				errors += "<end of schema>\n";
+			}
 		}
+		if (isValid(result, schemas.size()))
+			return std::string();
 		else
-		{
-			errors += error;
-			errors += "<end of schema>\n";
-		}
-	}
-	if (isValid(result))
-		return "";
-	else
-		return validator.makeErrorMessage(errorMsg) + errors;
+			return validator.makeErrorMessage(errorMsg) + errors;
+	};
 }
 
-static std::string allOfCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck allOfCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	return schemaListCheck(validator, baseSchema, schema, data, "Failed to pass all schemas", [&schema](size_t count)
+	return schemaListCheck(compiler, schema, "Failed to pass all schemas", [](size_t count, size_t total)
 	{
-		return count == schema.Vector().size();
+		return count == total;
 	});
 }
 
-static std::string anyOfCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck anyOfCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	return schemaListCheck(validator, baseSchema, schema, data, "Failed to pass any schema", [](size_t count)
+	return schemaListCheck(compiler, schema, "Failed to pass any schema", [](size_t count, size_t total)
 	{
 		return count > 0;
 	});
 }
 
-static std::string oneOfCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck oneOfCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	return schemaListCheck(validator, baseSchema, schema, data, "Failed to pass exactly one schema", [](size_t count)
+	return schemaListCheck(compiler, schema, "Failed to pass exactly one schema", [](size_t count, size_t total)
 	{
 		return count == 1;
 	});
 }
 
-static std::string notCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck notCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (validator.check(schema, data).empty())
-		return validator.makeErrorMessage("Successful validation against negative check");
-	return "";
-}
+	const CompiledSchema * negatedSchema = compiler.compile(schema);
 
-static std::string enumCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
-{
-	for(const auto & enumEntry : schema.Vector())
+	return [negatedSchema](JsonValidator & validator, const JsonNode & data)
 	{
-		if (data == enumEntry)
-			return "";
-	}
+		if (negatedSchema->check(validator, data).empty())
+			return validator.makeErrorMessage("Successful validation against negative check");
+		return std::string();
+	};
+}
 
+static TCheck enumCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
+{
 	std::string errorMessage = "Key must have one of predefined values:" + schema.toCompactString();
 
-	return validator.makeErrorMessage(errorMessage);
+	return [values = schema.Vector(), errorMessage](JsonValidator & validator, const JsonNode & data)
+	{
+		for(const auto & enumEntry : values)
+		{
+			if (data == enumEntry)
+				return std::string();
+		}
+
+		return validator.makeErrorMessage(errorMessage);
+	};
 }
 
-static std::string constCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck constCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (data == schema)
-		return "";
+	return [value = schema](JsonValidator & validator, const JsonNode & data)
+	{
+		if (data == value)
+			return std::string();
 
-	return validator.makeErrorMessage("Key must have have constant value");
+		return validator.makeErrorMessage("Key must have have constant value");
+	};
 }
 
-static std::string typeCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck typeCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
 	static const std::unordered_map<std::string, JsonNode::JsonType> stringToType =
 	{
@@ -207,108 +291,150 @@ static std::string typeCheck(JsonValidator & validator, const JsonNode & baseSch
 	auto it = stringToType.find(typeName);
 	if(it == stringToType.end())
 	{
-		return validator.makeErrorMessage("Unknown type in schema:" + typeName);
+		return [errorMessage = "Unknown type in schema:" + typeName](JsonValidator & validator, const JsonNode & data)
+		{
+			return validator.makeErrorMessage(errorMessage);
+		};
 	}
 
 	JsonNode::JsonType type = it->second;
 
-	// for "number" type both float and integer are allowed
-	if(type == JsonNode::JsonType::DATA_FLOAT && data.isNumber())
-		return "";
+	return [type, errorMessage = "Type mismatch! Expected " + typeName](JsonValidator & validator, const JsonNode & data)
+	{
+		// for "number" type both float and integer are allowed
+		if(type == JsonNode::JsonType::DATA_FLOAT && data.isNumber())
+			return std::string();
 
-	if(type != data.getType() && data.getType() != JsonNode::JsonType::DATA_NULL)
-		return validator.makeErrorMessage("Type mismatch! Expected " + schema.String());
-	return "";
+		if(type != data.getType() && data.getType() != JsonNode::JsonType::DATA_NULL)
+			return validator.makeErrorMessage(errorMessage);
+		return std::string();
+	};
 }
 
-static std::string refCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck refCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
 	std::string URI = schema.String();
 	//node must be validated using schema pointed by this reference and not by data here
 	//Local reference. Turn it into more easy to handle remote ref
 	if (boost::algorithm::starts_with(URI, "#"))
 	{
-		const std::string name = validator.usedSchemas.back();
+		const std::string & name = compiler.currentSchemaName();
 		const std::string nameClean = name.substr(0, name.find('#'));
 		URI = nameClean + URI;
 	}
-	return validator.check(URI, data);
+
+	const CompiledSchema * referencedSchema = compiler.compile(URI);
+
+	return [referencedSchema](JsonValidator & validator, const JsonNode & data)
+	{
+		return referencedSchema->check(validator, data);
+	};
 }
 
-static std::string formatCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck formatCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	auto formats = validator.getKnownFormats();
-	std::string errors;
+	const auto & formats = JsonValidator::getKnownFormats();
 	auto checker = formats.find(schema.String());
-	if (checker != formats.end())
+	if (checker == formats.end())
 	{
-		if (data.isString())
+		return [errorMessage = "Unsupported format type: " + schema.String()](JsonValidator & validator, const JsonNode & data)
 		{
-			std::string result = checker->second(data);
-			if (!result.empty())
-				errors += validator.makeErrorMessage(result);
-		}
-		else
-		{
-			errors += validator.makeErrorMessage("Format value must be string: " + schema.String());
-		}
+			return validator.makeErrorMessage(errorMessage);
+		};
 	}
-	else
-		errors += validator.makeErrorMessage("Unsupported format type: " + schema.String());
-	return errors;
+
+	return [formatValidator = checker->second, errorMessage = "Format value must be string: " + schema.String()](JsonValidator & validator, const JsonNode & data)
+	{
+		if (!data.isString())
+			return validator.makeErrorMessage(errorMessage);
+
+		std::string result = formatValidator(data);
+		if (!result.empty())
+			return validator.makeErrorMessage(result);
+		return std::string();
+	};
 }
 
-static std::string maxLengthCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+/// Creates check that compares numeric property of data, such as string length or value of number, against limit from schema
+template<typename Property, typename Comparator>
+static TCheck limitCheck(const JsonNode & schema, const std::string & errorFormat, Property property, Comparator isViolated)
 {
-	if (data.String().size() > schema.Float())
-		return validator.makeErrorMessage((boost::format("String is longer than %d symbols") % schema.Float()).str());
-	return "";
+	double limit = schema.Float();
+	std::string errorMessage = (boost::format(errorFormat) % limit).str();
+
+	return [limit, errorMessage, property, isViolated](JsonValidator & validator, const JsonNode & data)
+	{
+		if (isViolated(property(data), limit))
+			return validator.makeErrorMessage(errorMessage);
+		return std::string();
+	};
 }
 
-static std::string minLengthCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static size_t stringLength(const JsonNode & data)
 {
-	if (data.String().size() < schema.Float())
-		return validator.makeErrorMessage((boost::format("String is shorter than %d symbols") % schema.Float()).str());
-	return "";
+	return data.String().size();
 }
 
-static std::string maximumCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static double numberValue(const JsonNode & data)
 {
-	if (data.Float() > schema.Float())
-		return validator.makeErrorMessage((boost::format("Value is bigger than %d") % schema.Float()).str());
-	return "";
+	return data.Float();
 }
 
-static std::string minimumCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static size_t vectorSize(const JsonNode & data)
 {
-	if (data.Float() < schema.Float())
-		return validator.makeErrorMessage((boost::format("Value is smaller than %d") % schema.Float()).str());
-	return "";
+	return data.Vector().size();
 }
 
-static std::string exclusiveMaximumCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static size_t structSize(const JsonNode & data)
 {
-	if (data.Float() >= schema.Float())
-		return validator.makeErrorMessage((boost::format("Value is bigger than %d") % schema.Float()).str());
-	return "";
+	return data.Struct().size();
 }
 
-static std::string exclusiveMinimumCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck maxLengthCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (data.Float() <= schema.Float())
-		return validator.makeErrorMessage((boost::format("Value is smaller than %d") % schema.Float()).str());
-	return "";
+	return limitCheck(schema, "String is longer than %d symbols", stringLength, std::greater<double>());
 }
 
-static std::string multipleOfCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck minLengthCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	double result = data.Integer() / schema.Integer();
-	if (!vstd::isAlmostEqual(floor(result), result))
-		return validator.makeErrorMessage((boost::format("Value is not divisible by %d") % schema.Float()).str());
-	return "";
+	return limitCheck(schema, "String is shorter than %d symbols", stringLength, std::less<double>());
+}
+
+static TCheck maximumCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
+{
+	return limitCheck(schema, "Value is bigger than %d", numberValue, std::greater<double>());
+}
+
+static TCheck minimumCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
+{
+	return limitCheck(schema, "Value is smaller than %d", numberValue, std::less<double>());
 }
 
-static std::string itemEntryCheck(JsonValidator & validator, const JsonVector & items, const JsonNode & schema, size_t index)
+static TCheck exclusiveMaximumCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
+{
+	return limitCheck(schema, "Value is bigger than %d", numberValue, std::greater_equal<double>());
+}
+
+static TCheck exclusiveMinimumCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
+{
+	return limitCheck(schema, "Value is smaller than %d", numberValue, std::less_equal<double>());
+}
+
+static TCheck multipleOfCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
+{
+	si64 divisor = schema.Integer();
+	std::string errorMessage = (boost::format("Value is not divisible by %d") % schema.Float()).str();
+
+	return [divisor, errorMessage](JsonValidator & validator, const JsonNode & data)
+	{
+		double result = data.Integer() / divisor;
+		if (!vstd::isAlmostEqual(floor(result), result))
+			return validator.makeErrorMessage(errorMessage);
+		return std::string();
+	};
+}
+
+static std::string itemEntryCheck(JsonValidator & validator, const JsonVector & items, const CompiledSchema * schema, size_t index)
 {
 	validator.currentPath.emplace_back();
 	validator.currentPath.back().Float() = static_cast<double>(index);
@@ -317,63 +443,89 @@ static std::string itemEntryCheck(JsonValidator & validator, const JsonVector &
 		validator.currentPath.pop_back();
 	});
 
-	if (!schema.isNull())
-		return validator.check(schema, items[index]);
+	if (schema)
+		return schema->check(validator, items[index]);
 	return "";
 }
 
-static std::string itemsCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck itemsCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	std::string errors;
-	for (size_t i=0; i<data.Vector().size(); i++)
+	if (schema.getType() == JsonNode::JsonType::DATA_VECTOR)
 	{
-		if (schema.getType() == JsonNode::JsonType::DATA_VECTOR)
-		{
-			if (schema.Vector().size() > i)
-				errors += itemEntryCheck(validator, data.Vector(), schema.Vector()[i], i);
-		}
-		else
+		std::vector<const CompiledSchema *> itemSchemas;
+		for(const auto & itemSchema : schema.Vector())
+			itemSchemas.push_back(itemSchema.isNull() ? nullptr : compiler.compile(itemSchema));
+
+		return [itemSchemas](JsonValidator & validator, const JsonNode & data)
 		{
-			errors += itemEntryCheck(validator, data.Vector(), schema, i);
-		}
+			std::string errors;
+			for (size_t i=0; i<data.Vector().size() && i<itemSchemas.size(); i++)
+				errors += itemEntryCheck(validator, data.Vector(), itemSchemas[i], i);
+			return errors;
+		};
 	}
-	return errors;
+
+	if (schema.isNull())
+		return {};
+
+	const CompiledSchema * itemSchema = compiler.compile(schema);
+
+	return [itemSchema](JsonValidator & validator, const JsonNode & data)
+	{
+		std::string errors;
+		for (size_t i=0; i<data.Vector().size(); i++)
+			errors += itemEntryCheck(validator, data.Vector(), itemSchema, i);
+		return errors;
+	};
 }
 
-static std::string additionalItemsCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck additionalItemsCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	std::string errors;
 	// "items" is struct or empty (defaults to empty struct) - validation always successful
 	const JsonNode & items = baseSchema["items"];
 	if (items.getType() != JsonNode::JsonType::DATA_VECTOR)
-		return "";
+		return {};
+
+	size_t firstItem = items.Vector().size();
 
-	for (size_t i=items.Vector().size(); i<data.Vector().size(); i++)
+	if (schema.getType() == JsonNode::JsonType::DATA_STRUCT)
 	{
-		if (schema.getType() == JsonNode::JsonType::DATA_STRUCT)
-			errors += itemEntryCheck(validator, data.Vector(), schema, i);
-		else if(!schema.isNull() && !schema.Bool())
-			errors += validator.makeErrorMessage("Unknown entry found");
+		const CompiledSchema * itemSchema = compiler.compile(schema);
+
+		return [firstItem, itemSchema](JsonValidator & validator, const JsonNode & data)
+		{
+			std::string errors;
+			for (size_t i=firstItem; i<data.Vector().size(); i++)
+				errors += itemEntryCheck(validator, data.Vector(), itemSchema, i);
+			return errors;
+		};
 	}
-	return errors;
+
+	if(schema.isNull() || schema.Bool())
+		return {};
+
+	return [firstItem](JsonValidator & validator, const JsonNode & data)
+	{
+		std::string errors;
+		for (size_t i=firstItem; i<data.Vector().size(); i++)
+			errors += validator.makeErrorMessage("Unknown entry found");
+		return errors;
+	};
 }
 
-static std::string minItemsCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck minItemsCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (data.Vector().size() < schema.Float())
-		return validator.makeErrorMessage((boost::format("Length is smaller than %d") % schema.Float()).str());
-	return "";
+	return limitCheck(schema, "Length is smaller than %d", vectorSize, std::less<double>());
 }
 
-static std::string maxItemsCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck maxItemsCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (data.Vector().size() > schema.Float())
-		return validator.makeErrorMessage((boost::format("Length is bigger than %d") % schema.Float()).str());
-	return "";
+	return limitCheck(schema, "Length is bigger than %d", vectorSize, std::greater<double>());
 }
 
-static std::string uniqueItemsCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck uniqueItemsCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
+	// result of this check depends only on schema, so it can be evaluated during compilation
 	if (schema.Bool())
 	{
 		for (auto itA = schema.Vector().begin(); itA != schema.Vector().end(); itA++)
@@ -382,79 +534,127 @@ static std::string uniqueItemsCheck(JsonValidator & validator, const JsonNode &
 			while (++itB != schema.Vector().end())
 			{
 				if (*itA == *itB)
-					return validator.makeErrorMessage("List must consist from unique items");
+				{
+					return [](JsonValidator & validator, const JsonNode & data)
+					{
+						return validator.makeErrorMessage("List must consist from unique items");
+					};
+				}
 			}
 		}
 	}
-	return "";
+	return {};
 }
 
-static std::string maxPropertiesCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck maxPropertiesCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (data.Struct().size() > schema.Float())
-		return validator.makeErrorMessage((boost::format("Number of entries is bigger than %d") % schema.Float()).str());
-	return "";
+	return limitCheck(schema, "Number of entries is bigger than %d", structSize, std::greater<double>());
 }
 
-static std::string minPropertiesCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck minPropertiesCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	if (data.Struct().size() < schema.Float())
-		return validator.makeErrorMessage((boost::format("Number of entries is less than %d") % schema.Float()).str());
-	return "";
+	return limitCheck(schema, "Number of entries is less than %d", structSize, std::less<double>());
 }
 
-static std::string uniquePropertiesCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck uniquePropertiesCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	for (auto itA = data.Struct().begin(); itA != data.Struct().end(); itA++)
+	return [](JsonValidator & validator, const JsonNode & data)
 	{
-		auto itB = itA;
-		while (++itB != data.Struct().end())
+		for (auto itA = data.Struct().begin(); itA != data.Struct().end(); itA++)
 		{
-			if (itA->second == itB->second)
-				return validator.makeErrorMessage("List must consist from unique items");
+			auto itB = itA;
+			while (++itB != data.Struct().end())
+			{
+				if (itA->second == itB->second)
+					return validator.makeErrorMessage("List must consist from unique items");
+			}
 		}
-	}
-	return "";
+		return std::string();
+	};
 }
 
-static std::string requiredCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck requiredCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	std::string errors;
+	struct RequiredEntry
+	{
+		std::string name;
+		std::string errorMessage;
+	};
+
+	std::vector<RequiredEntry> requiredEntries;
 	for(const auto & required : schema.Vector())
+		requiredEntries.push_back({required.String(), "Required entry " + required.String() + " is missing"});
+
+	return [requiredEntries](JsonValidator & validator, const JsonNode & data)
 	{
-		if (data[required.String()].isNull())
-			errors += validator.makeErrorMessage("Required entry " + required.String() + " is missing");
-	}
-	return errors;
+		std::string errors;
+		for(const auto & required : requiredEntries)
+		{
+			if (data[required.name].isNull())
+				errors += validator.makeErrorMessage(required.errorMessage);
+		}
+		return errors;
+	};
 }
 
-static std::string dependenciesCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck dependenciesCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	std::string errors;
+	struct Dependency
+	{
+		std::string name;
+		/// list of properties that must be present along with this one, and error messages for them
+		std::vector<std::pair<std::string, std::string>> requiredProperties;
+		/// alternatively, schema that data must pass if this property is present
+		const CompiledSchema * requiredSchema = nullptr;
+		std::string errorMessage;
+	};
+
+	std::vector<Dependency> dependencies;
 	for(const auto & deps : schema.Struct())
 	{
-		if (!data[deps.first].isNull())
+		Dependency dependency;
+		dependency.name = deps.first;
+
+		if (deps.second.getType() == JsonNode::JsonType::DATA_VECTOR)
+		{
+			for(const auto & depEntry : deps.second.Vector())
+				dependency.requiredProperties.emplace_back(depEntry.String(), "Property " + depEntry.String() + " required for " + deps.first + " is missing");
+		}
+		else
+		{
+			dependency.requiredSchema = compiler.compile(deps.second);
+			dependency.errorMessage = "Requirements for " + deps.first + " are not fulfilled";
+		}
+		dependencies.push_back(dependency);
+	}
+
+	return [dependencies](JsonValidator & validator, const JsonNode & data)
+	{
+		std::string errors;
+		for(const auto & dependency : dependencies)
 		{
-			if (deps.second.getType() == JsonNode::JsonType::DATA_VECTOR)
+			if (data[dependency.name].isNull())
+				continue;
+
+			if (dependency.requiredSchema)
 			{
-				JsonVector depList = deps.second.Vector();
-				for(auto & depEntry : depList)
-				{
-					if (data[depEntry.String()].isNull())
-						errors += validator.makeErrorMessage("Property " + depEntry.String() + " required for " + deps.first + " is missing");
-				}
+				if (!dependency.requiredSchema->check(validator, data).empty())
+					errors += validator.makeErrorMessage(dependency.errorMessage);
 			}
 			else
 			{
-				if (!validator.check(deps.second, data).empty())
-					errors += validator.makeErrorMessage("Requirements for " + deps.first + " are not fulfilled");
+				for(const auto & depEntry : dependency.requiredProperties)
+				{
+					if (data[depEntry.first].isNull())
+						errors += validator.makeErrorMessage(depEntry.second);
+				}
 			}
 		}
-	}
-	return errors;
+		return errors;
+	};
 }
 
-static std::string propertyEntryCheck(JsonValidator & validator, const JsonNode &node, const JsonNode & schema, const std::string & nodeName)
+static std::string propertyEntryCheck(JsonValidator & validator, const JsonNode &node, const CompiledSchema & schema, const std::string & nodeName)
 {
 	validator.currentPath.emplace_back();
 	validator.currentPath.back().String() = nodeName;
@@ -463,44 +663,78 @@ static std::string propertyEntryCheck(JsonValidator & validator, const JsonNode
 		validator.currentPath.pop_back();
 	});
 
-	// there is schema specifically for this item
-	if (!schema.isNull())
-		return validator.check(schema, node);
-	return "";
+	return schema.check(validator, node);
 }
 
-static std::string propertiesCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck propertiesCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	std::string errors;
+	// only properties that have schema specifically for them need to be checked
+	std::unordered_map<std::string, const CompiledSchema *> properties;
+	for(const auto & entry : schema.Struct())
+	{
+		if (!entry.second.isNull())
+			properties[entry.first] = compiler.compile(entry.second);
+	}
 
-	for(const auto & entry : data.Struct())
-		errors += propertyEntryCheck(validator, entry.second, schema[entry.first], entry.first);
-	return errors;
+	return [properties](JsonValidator & validator, const JsonNode & data)
+	{
+		std::string errors;
+		for(const auto & entry : data.Struct())
+		{
+			auto it = properties.find(entry.first);
+			if (it != properties.end())
+				errors += propertyEntryCheck(validator, entry.second, *it->second, entry.first);
+		}
+		return errors;
+	};
 }
 
-static std::string additionalPropertiesCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
+static TCheck additionalPropertiesCheck(JsonSchemaCompiler & compiler, const JsonNode & baseSchema, const JsonNode & schema)
 {
-	std::string errors;
-	for(const auto & entry : data.Struct())
+	std::vector<std::string> knownPropertiesList;
+	for(const auto & entry : baseSchema["properties"].Struct())
+		knownPropertiesList.push_back(entry.first);
+
+	std::unordered_set<std::string> knownProperties(knownPropertiesList.begin(), knownPropertiesList.end());
+
+	// try generic additionalItems schema
+	if (schema.getType() == JsonNode::JsonType::DATA_STRUCT)
 	{
-		if (baseSchema["properties"].Struct().count(entry.first) == 0)
-		{
-			// try generic additionalItems schema
-			if (schema.getType() == JsonNode::JsonType::DATA_STRUCT)
-				errors += propertyEntryCheck(validator, entry.second, schema, entry.first);
+		const CompiledSchema * additionalSchema = compiler.compile(schema);
 
-			// or, additionalItems field can be bool which indicates if such items are allowed
-			else if(!schema.isNull() && !schema.Bool()) // present and set to false - error
+		return [knownProperties, additionalSchema](JsonValidator & validator, const JsonNode & data)
+		{
+			std::string errors;
+			for(const auto & entry : data.Struct())
 			{
-				std::string bestCandidate = findClosestMatch(baseSchema["properties"].Struct(), entry.first);
-				if (!bestCandidate.empty())
-					errors += validator.makeErrorMessage("Unknown entry found: '" + entry.first + "'. Perhaps you meant '" + bestCandidate + "'?");
-				else
-					errors += validator.makeErrorMessage("Unknown entry found: " + entry.first);
+				if (knownProperties.count(entry.first) == 0)
+					errors += propertyEntryCheck(validator, entry.second, *additionalSchema, entry.first);
 			}
-		}
+			return errors;
+		};
 	}
-	return errors;
+
+	// or, additionalItems field can be bool which indicates if such items are allowed
+	if(schema.isNull() || schema.Bool())
+		return {};
+
+	// present and set to false - error
+	return [knownProperties, knownPropertiesList](JsonValidator & validator, const JsonNode & data)
+	{
+		std::string errors;
+		for(const auto & entry : data.Struct())
+		{
+			if (knownProperties.count(entry.first) != 0)
+				continue;
+
+			std::string bestCandidate = findClosestMatch(knownPropertiesList, entry.first);
+			if (!bestCandidate.empty())
+				errors += validator.makeErrorMessage("Unknown entry found: '" + entry.first + "'. Perhaps you meant '" + bestCandidate + "'?");
+			else
+				errors += validator.makeErrorMessage("Unknown entry found: " + entry.first);
+		}
+		return errors;
+	};
 }
 
 static bool testFilePresence(const std::string & scope, const ResourcePath & resource)
@@ -581,9 +815,9 @@ static std::string videoFile(const JsonNode & node)
 }
 #undef TEST_FILE
 
-JsonValidator::TValidatorMap createCommonFields()
+TCompilerMap createCommonFields()
 {
-	JsonValidator::TValidatorMap ret;
+	TCompilerMap ret;
 
 	ret["format"] =  formatCheck;
 	ret["allOf"] = allOfCheck;
@@ -613,9 +847,9 @@ JsonValidator::TValidatorMap createCommonFields()
 	return ret;
 }
 
-JsonValidator::TValidatorMap createStringFields()
+TCompilerMap createStringFields()
 {
-	JsonValidator::TValidatorMap ret = createCommonFields();
+	TCompilerMap ret = createCommonFields();
 	ret["maxLength"] = maxLengthCheck;
 	ret["minLength"] = minLengthCheck;
 
@@ -623,9 +857,9 @@ JsonValidator::TValidatorMap createStringFields()
 	return ret;
 }
 
-JsonValidator::TValidatorMap createNumberFields()
+TCompilerMap createNumberFields()
 {
-	JsonValidator::TValidatorMap ret = createCommonFields();
+	TCompilerMap ret = createCommonFields();
 	ret["maximum"]    = maximumCheck;
 	ret["minimum"]    = minimumCheck;
 	ret["multipleOf"] = multipleOfCheck;
@@ -635,9 +869,9 @@ JsonValidator::TValidatorMap createNumberFields()
 	return ret;
 }
 
-JsonValidator::TValidatorMap createVectorFields()
+TCompilerMap createVectorFields()
 {
-	JsonValidator::TValidatorMap ret = createCommonFields();
+	TCompilerMap ret = createCommonFields();
 	ret["items"]           = itemsCheck;
 	ret["minItems"]        = minItemsCheck;
 	ret["maxItems"]        = maxItemsCheck;
@@ -646,9 +880,9 @@ JsonValidator::TValidatorMap createVectorFields()
 	return ret;
 }
 
-JsonValidator::TValidatorMap createStructFields()
+TCompilerMap createStructFields()
 {
-	JsonValidator::TValidatorMap ret = createCommonFields();
+	TCompilerMap ret = createCommonFields();
 	ret["additionalProperties"]  = additionalPropertiesCheck;
 	ret["uniqueProperties"]      = uniquePropertiesCheck;
 	ret["maxProperties"]         = maxPropertiesCheck;
@@ -679,57 +913,96 @@ JsonValidator::TFormatMap createFormatMap()
 	return ret;
 }
 
-std::string JsonValidator::makeErrorMessage(const std::string &message)
+const CompiledSchema * JsonSchemaCompiler::compile(const std::string & URI)
 {
-	std::string errors;
-	errors += "At ";
-	if (!currentPath.empty())
+	auto it = namedSchemas.find(URI);
+	if (it != namedSchemas.end())
+		return it->second.get();
+
+	auto pendingIt = pendingSchemas.find(URI);
+	if (pendingIt != pendingSchemas.end())
+		return pendingIt->second.get();
+
+	const bool outermost = usedSchemas.empty();
+	const size_t inlinedSchemasCount = inlinedSchemas.size();
+	auto * result = (pendingSchemas[URI] = std::make_unique<CompiledSchema>()).get();
+
+	usedSchemas.push_back(URI);
+	try
 	{
-		for(const JsonNode &path : currentPath)
+		compileFields(*result, JsonUtils::getSchema(URI));
+	}
+	catch(...)
+	{
+		usedSchemas.pop_back();
+		if (outermost)
 		{
-			errors += "/";
-			if (path.getType() == JsonNode::JsonType::DATA_STRING)
-				errors += path.String();
-			else
-				errors += std::to_string(static_cast<unsigned>(path.Float()));
+			// schemas compiled as part of failed one may point to it, so none of them can be kept
+			pendingSchemas.clear();
+			inlinedSchemas.erase(inlinedSchemas.begin() + inlinedSchemasCount, inlinedSchemas.end());
 		}
+		throw;
 	}
-	else
-		errors += "<root>";
-	errors += "\n\t Error: " + message + "\n";
-	return errors;
+	usedSchemas.pop_back();
+
+	if (outermost)
+		namedSchemas.merge(pendingSchemas);
+
+	return result;
 }
 
-std::string JsonValidator::check(const std::string & schemaName, const JsonNode & data)
+const CompiledSchema * JsonSchemaCompiler::compile(const JsonNode & schema)
 {
-	usedSchemas.push_back(schemaName);
-	auto onscopeExit = vstd::makeScopeGuard([this]()
-	{
-		usedSchemas.pop_back();
-	});
-	return check(JsonUtils::getSchema(schemaName), data);
+	auto * result = inlinedSchemas.emplace_back(std::make_unique<CompiledSchema>()).get();
+	compileFields(*result, schema);
+	return result;
 }
 
-std::string JsonValidator::check(const JsonNode & schema, const JsonNode & data)
+void JsonSchemaCompiler::compileFields(CompiledSchema & result, const JsonNode & schema)
 {
-	const TValidatorMap & knownFields = getKnownFieldsFor(data.getType());
-	std::string errors;
+	static const std::array allTypes = {
+		JsonNode::JsonType::DATA_NULL,
+		JsonNode::JsonType::DATA_BOOL,
+		JsonNode::JsonType::DATA_FLOAT,
+		JsonNode::JsonType::DATA_STRING,
+		JsonNode::JsonType::DATA_VECTOR,
+		JsonNode::JsonType::DATA_STRUCT,
+		JsonNode::JsonType::DATA_INTEGER
+	};
+
 	for(const auto & entry : schema.Struct())
 	{
-		auto checker = knownFields.find(entry.first);
-		if (checker != knownFields.end())
-			errors += checker->second(*this, schema, entry.second, data);
+		// same field may be used for multiple types of data, but is compiled only once
+		const TFieldCompiler * fieldCompiler = nullptr;
+		uint8_t types = 0;
+
+		for(const auto & type : allTypes)
+		{
+			const TCompilerMap & knownFields = getKnownFieldsFor(type);
+			auto it = knownFields.find(entry.first);
+			if (it != knownFields.end())
+			{
+				fieldCompiler = &it->second;
+				types |= 1 << static_cast<int>(type);
+			}
+		}
+
+		if (!fieldCompiler)
+			continue;
+
+		TCheck check = (*fieldCompiler)(*this, schema, entry.second);
+		if (check)
+			result.checks.push_back({std::move(check), types});
 	}
-	return errors;
 }
 
-const JsonValidator::TValidatorMap & JsonValidator::getKnownFieldsFor(JsonNode::JsonType type)
+const TCompilerMap & JsonSchemaCompiler::getKnownFieldsFor(JsonNode::JsonType type)
 {
-	static const TValidatorMap commonFields = createCommonFields();
-	static const TValidatorMap numberFields = createNumberFields();
-	static const TValidatorMap stringFields = createStringFields();
-	static const TValidatorMap vectorFields = createVectorFields();
-	static const TValidatorMap structFields = createStructFields();
+	static const TCompilerMap commonFields = createCommonFields();
+	static const TCompilerMap numberFields = createNumberFields();
+	static const TCompilerMap stringFields = createStringFields();
+	static const TCompilerMap vectorFields = createVectorFields();
+	static const TCompilerMap structFields = createStructFields();
 
 	switch (type)
 	{
@@ -743,6 +1016,41 @@ const JsonValidator::TValidatorMap & JsonValidator::getKnownFieldsFor(JsonNode::
 	}
 }
 
+std::string JsonValidator::makeErrorMessage(const std::string &message)
+{
+	std::string errors;
+	errors += "At ";
+	if (!currentPath.empty())
+	{
+		for(const JsonNode &path : currentPath)
+		{
+			errors += "/";
+			if (path.getType() == JsonNode::JsonType::DATA_STRING)
+				errors += path.String();
+			else
+				errors += std::to_string(static_cast<unsigned>(path.Float()));
+		}
+	}
+	else
+		errors += "<root>";
+	errors += "\n\t Error: " + message + "\n";
+	return errors;
+}
+
+std::string JsonValidator::check(const std::string & schemaName, const JsonNode & data)
+{
+	// compiled schemas are shared by all validators, but mod data may be validated by multiple threads at once
+	static JsonSchemaCompiler compiler;
+	static std::mutex compilerMutex;
+
+	const CompiledSchema * schema = nullptr;
+	{
+		TLockGuard lock(compilerMutex);
+		schema = compiler.compile(schemaName);
+	}
+	return schema->check(*this, data);
+}
+
 const JsonValidator::TFormatMap & JsonValidator::getKnownFormats()
 {
 	static const TFormatMap knownFormats = createFormatMap();
@@ -70,7 +70,7 @@ void CArmedInstance::updateMoraleBonusFromArmy()
 	std::set<FactionID> factions;
 	bool hasUndead = false;
 
-	const std::string undeadCacheKey = "type_UNDEAD";
+	static const auto undeadCacheKey = BonusCacheKey::type(BonusType::UNDEAD);
 	static const CSelector undeadSelector = Selector::type()(BonusType::UNDEAD);
 
 	for(const auto & slot : Slots())
@@ -118,7 +118,7 @@ void CArmedInstance::updateMoraleBonusFromArmy()
 	
 	b->description = bonusDescription;
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 
 	//-1 modifier for any Undead unit in army
 	auto undeadModifier = getExportedBonusList().getFirst(Selector::source(BonusSource::ARMY, BonusCustomSource::undeadMoraleDebuff));
@@ -29,6 +29,8 @@
 #include "../texts/Languages.h"
 #include "../VCMI_Lib.h"
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 static JsonNode loadModSettings(const JsonPath & path)
@@ -459,17 +461,22 @@ void CModHandler::load()
 
 	content->init();
 
-	for(const TModID & modName : activeMods)
-	{
-		logMod->trace("Generating checksum for %s", modName);
-		allMods[modName].updateChecksum(calculateModChecksum(modName, CResourceHandler::get(modName)));
-	}
-
 	// first - load virtual builtin mod that contains all data
 	// TODO? move all data into real mods? RoE, AB, SoD, WoG
-	content->preloadData(*coreMod);
+	std::vector<CModInfo *> modsToLoad = { coreMod.get() };
 	for(const TModID & modName : activeMods)
-		content->preloadData(allMods[modName]);
+		modsToLoad.push_back(&allMods.at(modName));
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(1, modsToLoad.size()), [&](const tbb::blocked_range<size_t> & range)
+	{
+		for(size_t i = range.begin(); i != range.end(); ++i)
+		{
+			logMod->trace("Generating checksum for %s", modsToLoad[i]->identifier);
+			modsToLoad[i]->updateChecksum(calculateModChecksum(modsToLoad[i]->identifier, CResourceHandler::get(modsToLoad[i]->identifier)));
+		}
+	});
+
+	content->preloadData(modsToLoad);
 	logMod->info("\tParsing mod data: %d ms", timer.getDiff());
 
 	content->load(*coreMod);
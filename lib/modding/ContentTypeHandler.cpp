@@ -12,6 +12,7 @@
 
 #include "CModHandler.h"
 #include "CModInfo.h"
+#include "ModDataCache.h"
 #include "ModScope.h"
 
 #include "../BattleFieldHandler.h"
@@ -30,6 +31,7 @@
 #include "../mapObjects/ObstacleSetHandler.h"
 #include "../RiverHandler.h"
 #include "../RoadHandler.h"
+#include "../ScopeGuard.h"
 #include "../ScriptHandler.h"
 #include "../constants/StringConstants.h"
 #include "../TerrainHandler.h"
@@ -39,6 +41,9 @@
 #include "../spells/CSpellHandler.h"
 #include "../VCMI_Lib.h"
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string & entityName):
@@ -52,10 +57,8 @@ ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string
 	}
 }
 
-bool ContentTypeHandler::preloadModData(const std::string & modName, const JsonNode & fileList, bool validate)
+void ContentTypeHandler::preloadModData(const std::string & modName, JsonNode data)
 {
-	bool result = false;
-	JsonNode data = JsonUtils::assembleFromFiles(fileList, result);
 	data.setModScope(modName);
 
 	ModInfo & modInfo = modData[modName];
@@ -87,18 +90,31 @@ bool ContentTypeHandler::preloadModData(const std::string & modName, const JsonN
 			JsonUtils::merge(remoteConf, entry.second);
 		}
 	}
-	return result;
 }
 
 bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
 {
 	ModInfo & modInfo = modData[modName];
-	bool result = true;
+	std::atomic<bool> result = true;
+
+	// Objects are prepared and loaded one by one in their original order, since handlers may depend on previously loaded objects.
+	// Only validation runs in background: it reads prepared object, same as loadObject does, and does not affect loading
+	tbb::task_group validation;
+	auto waitForValidation = vstd::makeScopeGuard([&validation]()
+	{
+		validation.wait();
+	});
 
 	auto performValidate = [&,this](JsonNode & data, const std::string & name){
 		handler->beforeValidate(data);
 		if (validate)
-			result &= JsonUtils::validate(data, "vcmi:" + entityName, name);
+		{
+			validation.run([&result, &data, &name, this]()
+			{
+				if (!JsonUtils::validate(data, "vcmi:" + entityName, name))
+					result = false;
+			});
+		}
 	};
 
 	// apply patches
@@ -154,6 +170,8 @@ bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
 			handler->loadObject(modName, name, data);
 		}
 	}
+
+	validation.wait();
 	return result;
 }
 
@@ -255,16 +273,6 @@ void CContentHandler::init()
 	handlers.insert(std::make_pair("biomes", ContentTypeHandler(VLC->biomeHandler.get(), "biome")));
 }
 
-bool CContentHandler::preloadModData(const std::string & modName, JsonNode modConfig, bool validate)
-{
-	bool result = true;
-	for(auto & handler : handlers)
-	{
-		result &= handler.second.preloadModData(modName, modConfig[handler.first], validate);
-	}
-	return result;
-}
-
 bool CContentHandler::loadMod(const std::string & modName, bool validate)
 {
 	bool result = true;
@@ -291,21 +299,82 @@ void CContentHandler::afterLoadFinalization()
 	}
 }
 
-void CContentHandler::preloadData(CModInfo & mod)
+void CContentHandler::preloadData(const std::vector<CModInfo *> & mods)
 {
-	bool validate = validateMod(mod);
+	std::vector<std::string> contentTypes;
+	for(const auto & handler : handlers)
+		contentTypes.push_back(handler.first);
+
+	// reading and parsing of files is independent for every mod and content type, so it can be done in parallel
+	std::vector<JsonNode> parsedData(mods.size() * contentTypes.size());
+	std::vector<uint8_t> parsedDataValid(mods.size() * contentTypes.size(), true);
+	std::vector<uint8_t> parsedDataCached(mods.size() * contentTypes.size(), false);
+	std::vector<ui32> checksums(mods.size() * contentTypes.size());
+
+	// content of unmodified files is taken from cache of previous start, without reading and parsing of json files
+	ModDataCache cache;
+	cache.load();
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, parsedData.size()), [&](const tbb::blocked_range<size_t> & range)
+	{
+		for(size_t i = range.begin(); i != range.end(); ++i)
+		{
+			const CModInfo & mod = *mods[i / contentTypes.size()];
+			const JsonNode & modConfig = mod.config;
+			size_t contentTypeIndex = i % contentTypes.size();
+			const JsonNode & fileList = modConfig[contentTypes[contentTypeIndex]];
 
-	// print message in format [<8-symbols checksum>] <modname>
-	auto & info = mod.getVerificationInfo();
-	logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+			checksums[i] = ModDataCache::calculateChecksum(fileList);
+			const JsonNode * cachedData = cache.find(mod.identifier, contentTypes[contentTypeIndex], checksums[i]);
 
-	if (validate && mod.identifier != ModScope::scopeBuiltin())
+			if (cachedData)
+			{
+				parsedData[i] = *cachedData;
+				parsedDataCached[i] = true;
+			}
+			else
+			{
+				bool isValid = false;
+				parsedData[i] = JsonUtils::assembleFromFiles(fileList, isValid);
+				parsedDataValid[i] = isValid;
+			}
+
+			if (contentTypeIndex == 0 && validateMod(mod) && mod.identifier != ModScope::scopeBuiltin())
+				parsedDataValid[i] &= JsonUtils::validate(modConfig, "vcmi:mod", mod.identifier);
+		}
+	});
+
+	// rebuild cache from scratch, so entries of removed mods or content types are dropped from it
+	if (vstd::contains(parsedDataCached, false))
 	{
-		if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
-			mod.validation = CModInfo::FAILED;
+		ModDataCache updatedCache;
+		for(size_t i = 0; i < parsedData.size(); ++i)
+		{
+			// data with errors is not cached, so errors will be reported again on next start
+			if (parsedDataValid[i])
+				updatedCache.store(mods[i / contentTypes.size()]->identifier, contentTypes[i % contentTypes.size()], checksums[i], parsedData[i]);
+		}
+		updatedCache.save();
+	}
+
+	// mods may patch objects from other mods, so parsed data must be merged in order of loading
+	for(size_t modIndex = 0; modIndex < mods.size(); ++modIndex)
+	{
+		CModInfo & mod = *mods[modIndex];
+
+		// print message in format [<8-symbols checksum>] <modname>
+		auto & info = mod.getVerificationInfo();
+		logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+
+		for(size_t contentTypeIndex = 0; contentTypeIndex < contentTypes.size(); ++contentTypeIndex)
+		{
+			size_t i = modIndex * contentTypes.size() + contentTypeIndex;
+
+			handlers.at(contentTypes[contentTypeIndex]).preloadModData(mod.identifier, std::move(parsedData[i]));
+			if (!parsedDataValid[i])
+				mod.validation = CModInfo::FAILED;
+		}
 	}
-	if (!preloadModData(mod.identifier, mod.config, validate))
-		mod.validation = CModInfo::FAILED;
 }
 
 void CContentHandler::load(CModInfo & mod)
@@ -41,7 +41,9 @@ public:
 
 	/// local version of methods in ContentHandler
 	/// returns true if loading was successful
-	bool preloadModData(const std::string & modName, const JsonNode & fileList, bool validate);
+	/// merges data that was read from files of this mod
+	void preloadModData(const std::string & modName, JsonNode data);
+	/// returns true if loading was successful
 	bool loadMod(const std::string & modName, bool validate);
 	void loadCustom();
 	void afterLoadFinalization();
@@ -50,9 +52,6 @@ public:
 /// class used to load all game data into handlers. Used only during loading
 class DLL_LINKAGE CContentHandler
 {
-	/// preloads all data from fileList as data from modName.
-	bool preloadModData(const std::string & modName, JsonNode modConfig, bool validate);
-
 	/// actually loads data in mod
 	bool loadMod(const std::string & modName, bool validate);
 
@@ -62,8 +61,8 @@ class DLL_LINKAGE CContentHandler
 public:
 	void init();
 
-	/// preloads all data from fileList as data from modName.
-	void preloadData(CModInfo & mod);
+	/// preloads all data of listed mods. Mods must be listed in order of loading
+	void preloadData(const std::vector<CModInfo *> & mods);
 
 	/// actually loads data in mod
 	void load(CModInfo & mod);
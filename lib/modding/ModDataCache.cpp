@@ -0,0 +1,132 @@
+/*
+ * ModDataCache.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ModDataCache.h"
+
+#include "../GameConstants.h"
+#include "../VCMIDirs.h"
+#include "../filesystem/Filesystem.h"
+#include "../serializer/CLoadFile.h"
+#include "../serializer/CSaveFile.h"
+
+#include <boost/crc.hpp>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+static const std::string cacheMagicBytes = "VCMI mod data cache";
+
+static boost::filesystem::path getCachePath()
+{
+	return VCMIDirs::get().userCachePath() / "modDataCache.bin";
+}
+
+std::string ModDataCache::getEntryName(const std::string & modName, const std::string & contentType)
+{
+	return modName + "/" + contentType;
+}
+
+ui32 ModDataCache::calculateChecksum(const JsonNode & fileList)
+{
+	boost::crc_32_type checksum;
+	// add current VCMI version into checksum to invalidate cache on VCMI updates, since data format may change
+	checksum.process_bytes(GameConstants::VCMI_VERSION.data(), GameConstants::VCMI_VERSION.size());
+
+	// list of files, or inlined data if mod defines its content directly in mod.json
+	std::string fileListString = fileList.toCompactString();
+	checksum.process_bytes(fileListString.data(), fileListString.size());
+
+	if (!fileList.isVector())
+		return checksum.checksum();
+
+	for(const auto & file : fileList.Vector())
+	{
+		JsonPath path = JsonPath::builtinTODO(file.String());
+
+		if (!CResourceHandler::get()->existsResource(path))
+			continue;
+
+		// file on disk is identified by its location, size and modification time, so its content does not need to be read
+		auto fileName = CResourceHandler::get()->getResourceName(path);
+		boost::system::error_code ec;
+		if (fileName)
+		{
+			std::string location = fileName->string();
+			auto fileSize = static_cast<ui64>(boost::filesystem::file_size(*fileName, ec));
+			auto writeTime = static_cast<si64>(boost::filesystem::last_write_time(*fileName, ec));
+
+			if (!ec)
+			{
+				checksum.process_bytes(location.data(), location.size());
+				checksum.process_bytes(&fileSize, sizeof(fileSize));
+				checksum.process_bytes(&writeTime, sizeof(writeTime));
+				continue;
+			}
+		}
+
+		// otherwise (e.g. file in archive) fall back to checksum of content. For zip archives it is stored in archive itself
+		ui32 fileChecksum = CResourceHandler::get()->load(path)->calculateCRC32();
+		checksum.process_bytes(&fileChecksum, sizeof(fileChecksum));
+	}
+	return checksum.checksum();
+}
+
+void ModDataCache::load()
+{
+	const auto path = getCachePath();
+
+	if (!boost::filesystem::exists(path))
+		return;
+
+	try
+	{
+		CLoadFile file(path, ESerializationVersion::CURRENT);
+		file.checkMagicBytes(cacheMagicBytes);
+		file >> entries;
+	}
+	catch(const std::exception & e)
+	{
+		logMod->warn("Failed to load mod data cache: %s", e.what());
+		entries.clear();
+	}
+}
+
+void ModDataCache::save() const
+{
+	try
+	{
+		CSaveFile file(getCachePath());
+		file.putMagicBytes(cacheMagicBytes);
+		file << entries;
+		file.writeToDisk();
+	}
+	catch(const std::exception & e)
+	{
+		logMod->warn("Failed to save mod data cache: %s", e.what());
+	}
+}
+
+const JsonNode * ModDataCache::find(const std::string & modName, const std::string & contentType, ui32 checksum) const
+{
+	auto it = entries.find(getEntryName(modName, contentType));
+
+	if (it == entries.end() || it->second.checksum != checksum)
+		return nullptr;
+
+	return &it->second.data;
+}
+
+void ModDataCache::store(const std::string & modName, const std::string & contentType, ui32 checksum, const JsonNode & data)
+{
+	auto & entry = entries[getEntryName(modName, contentType)];
+	entry.checksum = checksum;
+	entry.data = data;
+}
+
+VCMI_LIB_NAMESPACE_END
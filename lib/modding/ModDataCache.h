@@ -0,0 +1,54 @@
+/*
+ * ModDataCache.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../json/JsonNode.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// On-disk cache of parsed content of mods, stored in binary form
+/// Allows to skip reading and parsing of json files of mods that were not modified since previous start
+class DLL_LINKAGE ModDataCache
+{
+	struct Entry
+	{
+		ui32 checksum = 0;
+		JsonNode data;
+
+		template <typename Handler> void serialize(Handler & h)
+		{
+			h & checksum;
+			h & data;
+		}
+	};
+
+	/// content type of specific mod, in form "modName/contentType" -> parsed data
+	std::map<std::string, Entry> entries;
+
+	static std::string getEntryName(const std::string & modName, const std::string & contentType);
+
+public:
+	/// Calculates checksum of content type of mod, that covers its list of files and size and modification time of these files
+	/// Content of file is checksummed only if file metadata is not available
+	static ui32 calculateChecksum(const JsonNode & fileList);
+
+	/// Loads cache from disk. Missing or outdated cache is silently ignored
+	void load();
+
+	/// Writes cache to disk, replacing previously stored cache
+	void save() const;
+
+	/// Returns cached data if it was created from files with matching checksum
+	const JsonNode * find(const std::string & modName, const std::string & contentType, ui32 checksum) const;
+
+	void store(const std::string & modName, const std::string & contentType, ui32 checksum, const JsonNode & data);
+};
+
+VCMI_LIB_NAMESPACE_END
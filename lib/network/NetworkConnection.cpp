@@ -134,42 +134,72 @@ void NetworkConnection::setAsyncWritesEnabled(bool on)
 	asyncWritesEnabled = on;
 }
 
+NetworkConnection::OutgoingMessage::OutgoingMessage(std::vector<std::byte> && payload)
+	: header(payload.size())
+	, payload(std::move(payload))
+{
+}
+
+std::array<boost::asio::const_buffer, 2> NetworkConnection::OutgoingMessage::buffers() const
+{
+	return { boost::asio::buffer(&header, sizeof(header)), boost::asio::buffer(payload) };
+}
+
 void NetworkConnection::sendPacket(const std::vector<std::byte> & message)
 {
 	std::lock_guard lock(writeMutex);
-	std::vector<std::byte> headerVector(sizeof(uint32_t));
-	uint32_t messageSize = message.size();
-	std::memcpy(headerVector.data(), &messageSize, sizeof(uint32_t));
 
 	// At the moment, vcmilobby *requires* async writes in order to handle multiple connections with different speeds and at optimal performance
 	// However server (and potentially - client) can not handle this mode and may shutdown either socket or entire asio service too early, before all writes are performed
 	if (asyncWritesEnabled)
 	{
+		// caller keeps ownership of message, so its data must be copied into send queue
+		enqueueMessage(std::vector<std::byte>(message));
+	}
+	else
+	{
+		uint32_t messageSize = message.size();
+		std::array<boost::asio::const_buffer, 2> buffers = { boost::asio::buffer(&messageSize, sizeof(messageSize)), boost::asio::buffer(message) };
 
-		bool messageQueueEmpty = dataToSend.empty();
-		dataToSend.push_back(headerVector);
-		if (!message.empty())
-			dataToSend.push_back(message);
+		boost::system::error_code ec;
+		boost::asio::write(*socket, buffers, ec);
+	}
+}
 
-		if (messageQueueEmpty)
-			doSendData();
-		//else - data sending loop is still active and still sending previous messages
+void NetworkConnection::sendPacket(std::vector<std::byte> && message)
+{
+	std::lock_guard lock(writeMutex);
+
+	if (asyncWritesEnabled)
+	{
+		enqueueMessage(std::move(message));
 	}
 	else
 	{
+		OutgoingMessage outgoing(std::move(message));
+
 		boost::system::error_code ec;
-		boost::asio::write(*socket, boost::asio::buffer(headerVector), ec );
-		if (!message.empty())
-			boost::asio::write(*socket, boost::asio::buffer(message), ec );
+		boost::asio::write(*socket, outgoing.buffers(), ec);
 	}
 }
 
+void NetworkConnection::enqueueMessage(std::vector<std::byte> && message)
+{
+	bool messageQueueEmpty = dataToSend.empty();
+	dataToSend.emplace_back(std::move(message));
+
+	if (messageQueueEmpty)
+		doSendData();
+	//else - data sending loop is still active and still sending previous messages
+}
+
 void NetworkConnection::doSendData()
 {
 	if (dataToSend.empty())
 		throw std::runtime_error("Attempting to sent data but there is no data to send!");
 
-	boost::asio::async_write(*socket, boost::asio::buffer(dataToSend.front()), [self = shared_from_this()](const auto & error, const auto & )
+	// std::list guarantees that header and payload of queued message remain at the same address until write is complete
+	boost::asio::async_write(*socket, dataToSend.front().buffers(), [self = shared_from_this()](const auto & error, const auto & )
 	{
 		self->onDataSent(error);
 	});
@@ -18,7 +18,17 @@ class NetworkConnection final : public INetworkConnection, public std::enable_sh
 	static const int messageHeaderSize = sizeof(uint32_t);
 	static const int messageMaxSize = 64 * 1024 * 1024; // arbitrary size to prevent potential massive allocation if we receive garbage input
 
-	std::list<std::vector<std::byte>> dataToSend;
+	/// Message queued for sending, header is stored next to payload so both can be sent in a single gathered write
+	struct OutgoingMessage
+	{
+		uint32_t header;
+		std::vector<std::byte> payload;
+
+		explicit OutgoingMessage(std::vector<std::byte> && payload);
+		std::array<boost::asio::const_buffer, 2> buffers() const;
+	};
+
+	std::list<OutgoingMessage> dataToSend;
 	std::shared_ptr<NetworkSocket> socket;
 	std::shared_ptr<NetworkTimer> timer;
 	std::mutex writeMutex;
@@ -34,6 +44,7 @@ class NetworkConnection final : public INetworkConnection, public std::enable_sh
 	void onHeaderReceived(const boost::system::error_code & ec);
 	void onPacketReceived(const boost::system::error_code & ec, uint32_t expectedPacketSize);
 
+	void enqueueMessage(std::vector<std::byte> && message);
 	void doSendData();
 	void onDataSent(const boost::system::error_code & ec);
 
@@ -43,6 +54,7 @@ public:
 	void start();
 	void close() override;
 	void sendPacket(const std::vector<std::byte> & message) override;
+	void sendPacket(std::vector<std::byte> && message) override;
 	void setAsyncWritesEnabled(bool on) override;
 };
 
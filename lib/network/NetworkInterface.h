@@ -17,6 +17,8 @@ class DLL_LINKAGE INetworkConnection : boost::noncopyable
 public:
 	virtual ~INetworkConnection() = default;
 	virtual void sendPacket(const std::vector<std::byte> & message) = 0;
+	/// Sends packet, taking ownership of its data to avoid copying it into send queue
+	virtual void sendPacket(std::vector<std::byte> && message) = 0;
 	virtual void setAsyncWritesEnabled(bool on) = 0;
 	virtual void close() = 0;
 };
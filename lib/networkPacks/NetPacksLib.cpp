@@ -2068,7 +2068,10 @@ void BattleTriggerEffect::applyGs(CGameState *gs)
 		auto b = st->getLocalBonus(Selector::source(BonusSource::SPELL_EFFECT, SpellID(SpellID::POISON))
 				.And(Selector::type()(BonusType::STACK_HEALTH)));
 		if (b)
+		{
 			b->val = val;
+			st->nodeHasChanged();
+		}
 		break;
 	}
 	case BonusType::ENCHANTER:
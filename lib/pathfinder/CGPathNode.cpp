@@ -55,7 +55,6 @@ int3 CGPath::endPos() const
 CPathsInfo::CPathsInfo(const int3 & Sizes, const CGHeroInstance * hero_)
 	: sizes(Sizes), hero(hero_)
 {
-	nodes.resize(boost::extents[ELayer::NUM_LAYERS][sizes.z][sizes.x][sizes.y]);
 }
 
 CPathsInfo::~CPathsInfo() = default;
@@ -87,11 +86,16 @@ bool CPathsInfo::getPath(CGPath & out, const int3 & dst) const
 
 const CGPathNode * CPathsInfo::getNode(const int3 & coord) const
 {
-	const auto * landNode = &nodes[ELayer::LAND][coord.z][coord.x][coord.y];
-	if(landNode->reachable())
+	static const CGPathNode unreachableNode;
+
+	const auto * landNode = hasLayer(ELayer::LAND) ? &nodes[ELayer::LAND][getNodeIndex(coord)] : nullptr;
+	if(landNode && landNode->reachable())
 		return landNode;
-	else
-		return &nodes[ELayer::SAIL][coord.z][coord.x][coord.y];
+
+	if(hasLayer(ELayer::SAIL))
+		return &nodes[ELayer::SAIL][getNodeIndex(coord)];
+
+	return landNode ? landNode : &unreachableNode;
 }
 
 PathNodeInfo::PathNodeInfo()
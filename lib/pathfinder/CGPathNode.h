@@ -12,8 +12,6 @@
 #include "../GameConstants.h"
 #include "../int3.h"
 
-#include <boost/heap/fibonacci_heap.hpp>
-
 VCMI_LIB_NAMESPACE_BEGIN
 
 class CGHeroInstance;
@@ -21,6 +19,7 @@ class CGObjectInstance;
 class CGameState;
 class CPathfinderHelper;
 struct TerrainTile;
+struct CGPathNode;
 
 template<typename N>
 struct DLL_LINKAGE NodeComparer
@@ -32,6 +31,44 @@ struct DLL_LINKAGE NodeComparer
 	}
 };
 
+/// 4-ary min-heap of path nodes ordered by cost
+/// Position of every queued node is stored in the node itself, so cost of queued node can be updated
+/// without searching and no memory is allocated per push, unlike node-based heaps
+class DLL_LINKAGE CPathNodeQueue
+{
+	static constexpr size_t ARITY = 4;
+
+	std::vector<CGPathNode *> heap;
+
+	inline void place(CGPathNode * node, size_t index);
+	inline void siftUp(size_t index);
+	inline void siftDown(size_t index);
+
+public:
+	bool empty() const
+	{
+		return heap.empty();
+	}
+
+	size_t size() const
+	{
+		return heap.size();
+	}
+
+	CGPathNode * top() const
+	{
+		return heap.front();
+	}
+
+	inline void push(CGPathNode * node);
+	inline void pop();
+
+	/// Restores heap order after cost of queued node was decreased
+	inline void costDecreased(CGPathNode * node);
+	/// Restores heap order after cost of queued node was increased
+	inline void costIncreased(CGPathNode * node);
+};
+
 enum class EPathAccessibility : ui8
 {
 	NOT_SET,
@@ -59,11 +96,10 @@ enum class EPathNodeAction : ui8
 
 struct DLL_LINKAGE CGPathNode
 {
-	using TFibHeap = boost::heap::fibonacci_heap<CGPathNode *, boost::heap::compare<NodeComparer<CGPathNode>>>;
 	using ELayer = EPathfindingLayer;
 
-	TFibHeap::handle_type pqHandle;
-	TFibHeap * pq;
+	// fields are ordered to avoid padding - CPathsInfo stores one node per tile and layer
+	CPathNodeQueue * pq; // queue this node is currently in, if any
 	CGPathNode * theNodeBefore;
 
 	int3 coord; //coordinates
@@ -71,6 +107,7 @@ struct DLL_LINKAGE CGPathNode
 
 	float cost; //total cost of the path to this tile measured in turns with fractions
 	int moveRemains; //remaining movement points after hero reaches the tile
+	uint32_t pqIndex; // position of this node in queue
 	ui8 turns; //how many turns we have to wait before reaching the tile - 0 means current turn
 	EPathAccessibility accessible;
 	EPathNodeAction action;
@@ -79,7 +116,7 @@ struct DLL_LINKAGE CGPathNode
 	CGPathNode()
 		: coord(-1),
 		layer(ELayer::WRONG),
-		pqHandle(nullptr)
+		pqIndex(0)
 	{
 		reset();
 	}
@@ -122,11 +159,11 @@ struct DLL_LINKAGE CGPathNode
 		{
 			if(getUpNode)
 			{
-				pq->increase(this->pqHandle);
+				pq->costDecreased(this);
 			}
 			else
 			{
-				pq->decrease(this->pqHandle);
+				pq->costIncreased(this);
 			}
 		}
 	}
@@ -166,6 +203,95 @@ struct DLL_LINKAGE CGPathNode
 	}
 };
 
+void CPathNodeQueue::place(CGPathNode * node, size_t index)
+{
+	heap[index] = node;
+	node->pqIndex = static_cast<uint32_t>(index);
+}
+
+void CPathNodeQueue::siftUp(size_t index)
+{
+	CGPathNode * node = heap[index];
+	const float cost = node->getCost();
+
+	while(index > 0)
+	{
+		size_t parent = (index - 1) / ARITY;
+		if(heap[parent]->getCost() <= cost)
+			break;
+
+		place(heap[parent], index);
+		index = parent;
+	}
+	place(node, index);
+}
+
+void CPathNodeQueue::siftDown(size_t index)
+{
+	CGPathNode * node = heap[index];
+	const float cost = node->getCost();
+
+	for(;;)
+	{
+		const size_t firstChild = index * ARITY + 1;
+		if(firstChild >= heap.size())
+			break;
+
+		const size_t lastChild = std::min(firstChild + ARITY, heap.size());
+		size_t best = firstChild;
+		for(size_t child = firstChild + 1; child < lastChild; ++child)
+		{
+			if(heap[child]->getCost() < heap[best]->getCost())
+				best = child;
+		}
+
+		if(cost <= heap[best]->getCost())
+			break;
+
+		place(heap[best], index);
+		index = best;
+	}
+	place(node, index);
+}
+
+void CPathNodeQueue::push(CGPathNode * node)
+{
+	assert(!node->inPQ());
+
+	node->pq = this;
+	heap.push_back(node);
+	siftUp(heap.size() - 1);
+}
+
+void CPathNodeQueue::pop()
+{
+	assert(!heap.empty());
+
+	heap.front()->pq = nullptr;
+	if(heap.size() > 1)
+	{
+		heap.front() = heap.back();
+		heap.pop_back();
+		siftDown(0);
+	}
+	else
+	{
+		heap.pop_back();
+	}
+}
+
+void CPathNodeQueue::costDecreased(CGPathNode * node)
+{
+	assert(node->pq == this);
+	siftUp(node->pqIndex);
+}
+
+void CPathNodeQueue::costIncreased(CGPathNode * node)
+{
+	assert(node->pq == this);
+	siftDown(node->pqIndex);
+}
+
 struct DLL_LINKAGE CGPath
 {
 	std::vector<CGPathNode> nodes; //just get node by node
@@ -188,7 +314,9 @@ struct DLL_LINKAGE CPathsInfo
 	const CGHeroInstance * hero;
 	int3 hpos;
 	int3 sizes;
-	boost::multi_array<CGPathNode, 4> nodes; //[layer][level][w][h]
+	/// [layer][level][w][h], flattened. Layers are allocated on first access, so layers that hero
+	/// can't use (e.g. sea on map without water or air without flying) take no memory
+	std::array<std::vector<CGPathNode>, ELayer::NUM_LAYERS> nodes;
 
 	CPathsInfo(const int3 & Sizes, const CGHeroInstance * hero_);
 	~CPathsInfo();
@@ -196,10 +324,27 @@ struct DLL_LINKAGE CPathsInfo
 	bool getPath(CGPath & out, const int3 & dst) const;
 	const CGPathNode * getNode(const int3 & coord) const;
 
+	STRONG_INLINE
+	bool hasLayer(const ELayer layer) const
+	{
+		return !nodes[layer.getNum()].empty();
+	}
+
 	STRONG_INLINE
 	CGPathNode * getNode(const int3 & coord, const ELayer layer)
 	{
-		return &nodes[layer.getNum()][coord.z][coord.x][coord.y];
+		auto & layerNodes = nodes[layer.getNum()];
+		if(layerNodes.empty())
+			layerNodes.resize(sizes.z * sizes.x * sizes.y);
+
+		return &layerNodes[getNodeIndex(coord)];
+	}
+
+private:
+	STRONG_INLINE
+	size_t getNodeIndex(const int3 & coord) const
+	{
+		return (coord.z * sizes.x + coord.x) * sizes.y + coord.y;
 	}
 };
 
@@ -83,11 +83,7 @@ CPathfinder::CPathfinder(CGameState * _gs, std::shared_ptr<PathfinderConfig> con
 void CPathfinder::push(CGPathNode * node)
 {
 	if(node && !node->inPQ())
-	{
-		node->pq = &this->pq;
-		auto handle = pq.push(node);
-		node->pqHandle = handle;
-	}
+		pq.push(node);
 }
 
 CGPathNode * CPathfinder::topAndPop()
@@ -95,7 +91,6 @@ CGPathNode * CPathfinder::topAndPop()
 	auto * node = pq.top();
 
 	pq.pop();
-	node->pq = nullptr;
 	return node;
 }
 
@@ -121,7 +116,7 @@ void CPathfinder::calculatePaths()
 		if(hlp->isHeroPatrolLocked())
 			continue;
 
-		pq.push(initialNode);
+		push(initialNode);
 	}
 
 	std::vector<CGPathNode *> neighbourNodes;
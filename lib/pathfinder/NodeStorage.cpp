@@ -21,6 +21,46 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+PlayerTileAccessibility::PlayerTileAccessibility(const CGameState * gs, const PlayerColor & player, bool includeAir)
+	: sizes(gs->getMapSize())
+{
+	int3 pos;
+	const auto & fow = static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(player)->fogOfWarMap;
+
+	for(auto & layerTiles : tiles)
+		layerTiles.resize(sizes.z * sizes.x * sizes.y, EPathAccessibility::NOT_SET);
+
+	auto * landTiles = tiles[ELayer::LAND].data();
+	auto * sailTiles = tiles[ELayer::SAIL].data();
+	auto * waterTiles = tiles[ELayer::WATER].data();
+	auto * airTiles = tiles[ELayer::AIR].data();
+
+	size_t index = 0;
+	for(pos.z=0; pos.z < sizes.z; ++pos.z)
+	{
+		for(pos.x=0; pos.x < sizes.x; ++pos.x)
+		{
+			for(pos.y=0; pos.y < sizes.y; ++pos.y, ++index)
+			{
+				const TerrainTile & tile = gs->map->getTile(pos);
+				if(tile.terType->isWater())
+				{
+					sailTiles[index] = PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs);
+					if(includeAir)
+						airTiles[index] = PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs);
+					waterTiles[index] = PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs);
+				}
+				if(tile.terType->isLand())
+				{
+					landTiles[index] = PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs);
+					if(includeAir)
+						airTiles[index] = PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs);
+				}
+			}
+		}
+	}
+}
+
 void NodeStorage::initialize(const PathfinderOptions & options, const CGameState * gs)
 {
 	//TODO: fix this code duplication with AINodeStorage::initialize, problem is to keep `resetTile` inline
@@ -28,12 +68,36 @@ void NodeStorage::initialize(const PathfinderOptions & options, const CGameState
 	int3 pos;
 	const PlayerColor player = out.hero->tempOwner;
 	const int3 sizes = gs->getMapSize();
-	const auto & fow = static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(player)->fogOfWarMap;
 
 	//make 200% sure that these are loop invariants (also a bit shorter code), let compiler do the rest(loop unswitching)
 	const bool useFlying = options.useFlying;
 	const bool useWaterWalking = options.useWaterWalking;
 
+	if(accessibility)
+	{
+		for(pos.z=0; pos.z < sizes.z; ++pos.z)
+		{
+			for(pos.x=0; pos.x < sizes.x; ++pos.x)
+			{
+				for(pos.y=0; pos.y < sizes.y; ++pos.y)
+				{
+					for(ELayer layer = ELayer::LAND; layer < ELayer::NUM_LAYERS; layer.advance(1))
+					{
+						if((layer == ELayer::AIR && !useFlying) || (layer == ELayer::WATER && !useWaterWalking))
+							continue;
+
+						EPathAccessibility tileAccessibility = accessibility->get(pos, layer);
+						if(tileAccessibility != EPathAccessibility::NOT_SET)
+							resetTile(pos, layer, tileAccessibility);
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	const auto & fow = static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(player)->fogOfWarMap;
+
 	for(pos.z=0; pos.z < sizes.z; ++pos.z)
 	{
 		for(pos.x=0; pos.x < sizes.x; ++pos.x)
@@ -70,6 +134,10 @@ void NodeStorage::calculateNeighbours(
 	NeighbourTilesVector accessibleNeighbourTiles;
 	
 	result.clear();
+
+	// layer was never initialized, so none of its nodes can be accessible
+	if(!out.hasLayer(layer))
+		return;
 	
 	pathfinderHelper->calculateNeighbourTiles(accessibleNeighbourTiles, source);
 
@@ -112,8 +180,9 @@ std::vector<CGPathNode *> NodeStorage::calculateTeleportations(
 	return neighbours;
 }
 
-NodeStorage::NodeStorage(CPathsInfo & pathsInfo, const CGHeroInstance * hero)
+NodeStorage::NodeStorage(CPathsInfo & pathsInfo, const CGHeroInstance * hero, std::shared_ptr<const PlayerTileAccessibility> accessibility)
 	:out(pathsInfo)
+	,accessibility(std::move(accessibility))
 {
 	out.hero = hero;
 	out.hpos = hero->visitablePos();
@@ -14,16 +14,37 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Accessibility of all map tiles on all layers, as seen by specific player
+/// Does not depend on hero, so it can be evaluated once and shared by pathfinding of all heroes of the player
+class DLL_LINKAGE PlayerTileAccessibility
+{
+	using ELayer = EPathfindingLayer;
+
+	int3 sizes;
+	std::array<std::vector<EPathAccessibility>, EPathfindingLayer::NUM_LAYERS> tiles; // NOT_SET if tile does not exist on layer
+
+public:
+	/// If includeAir is false, air layer is left NOT_SET and will not be available to any hero
+	PlayerTileAccessibility(const CGameState * gs, const PlayerColor & player, bool includeAir);
+
+	STRONG_INLINE
+	EPathAccessibility get(const int3 & tile, const EPathfindingLayer & layer) const
+	{
+		return tiles[layer.getNum()][(tile.z * sizes.x + tile.x) * sizes.y + tile.y];
+	}
+};
+
 class DLL_LINKAGE NodeStorage : public INodeStorage
 {
 private:
 	CPathsInfo & out;
+	std::shared_ptr<const PlayerTileAccessibility> accessibility; // precalculated accessibility, if available
 
 	STRONG_INLINE
 	void resetTile(const int3 & tile, const EPathfindingLayer & layer, EPathAccessibility accessibility);
 
 public:
-	NodeStorage(CPathsInfo & pathsInfo, const CGHeroInstance * hero);
+	NodeStorage(CPathsInfo & pathsInfo, const CGHeroInstance * hero, std::shared_ptr<const PlayerTileAccessibility> accessibility = nullptr);
 
 	STRONG_INLINE
 	CGPathNode * getNode(const int3 & coord, const EPathfindingLayer layer)
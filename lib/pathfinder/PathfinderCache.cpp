@@ -0,0 +1,106 @@
+/*
+ * PathfinderCache.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "PathfinderCache.h"
+
+#include "CGPathNode.h"
+#include "../CGameInfoCallback.h"
+#include "../mapObjects/CGHeroInstance.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+PathfinderCache::HeroState::HeroState(const CGHeroInstance * hero)
+	: position(hero->visitablePos())
+	, movementPoints(hero->movementPointsRemaining())
+	, mana(hero->mana)
+	, inBoat(hero->boat != nullptr)
+	, bonusesVersion(hero->getTreeVersion())
+{
+}
+
+bool PathfinderCache::HeroState::operator==(const HeroState & other) const
+{
+	return position == other.position
+		&& movementPoints == other.movementPoints
+		&& mana == other.mana
+		&& inBoat == other.inBoat
+		&& bonusesVersion == other.bonusesVersion;
+}
+
+PathfinderCache::PathfinderCache(CGameInfoCallback * cb)
+	: cb(cb)
+{
+}
+
+std::shared_ptr<const CPathsInfo> PathfinderCache::getPathsInfo(const CGHeroInstance * hero)
+{
+	assert(hero);
+	boost::unique_lock<boost::mutex> lock(pathsMutex);
+
+	HeroState currentState(hero);
+
+	auto iter = paths.find(hero);
+	if(iter != paths.end() && iter->second.state == currentState)
+		return iter->second.paths;
+
+	auto result = std::make_shared<CPathsInfo>(cb->getMapSize(), hero);
+	cb->calculatePaths(hero, *result);
+
+	paths.insert_or_assign(hero, CachedPaths{currentState, result});
+	return result;
+}
+
+std::vector<std::shared_ptr<const CPathsInfo>> PathfinderCache::getPathsInfo(const std::vector<const CGHeroInstance *> & heroes)
+{
+	boost::unique_lock<boost::mutex> lock(pathsMutex);
+
+	std::vector<std::shared_ptr<const CPathsInfo>> result;
+	std::vector<std::pair<const CGHeroInstance *, CachedPaths>> outdatedPaths;
+	std::vector<CPathsInfo *> toCalculate;
+
+	for(const auto * hero : heroes)
+	{
+		assert(hero);
+
+		HeroState currentState(hero);
+		auto iter = paths.find(hero);
+		if(iter != paths.end() && iter->second.state == currentState)
+		{
+			result.push_back(iter->second.paths);
+			continue;
+		}
+
+		auto heroPaths = std::make_shared<CPathsInfo>(cb->getMapSize(), hero);
+		outdatedPaths.emplace_back(hero, CachedPaths{currentState, heroPaths});
+		toCalculate.push_back(heroPaths.get());
+		result.push_back(heroPaths);
+	}
+
+	cb->calculatePaths(toCalculate);
+
+	// cache only after successful calculation, so failed one will be retried on next request
+	for(auto & entry : outdatedPaths)
+		paths.insert_or_assign(entry.first, std::move(entry.second));
+	return result;
+}
+
+void PathfinderCache::invalidatePaths()
+{
+	boost::unique_lock<boost::mutex> lock(pathsMutex);
+	paths.clear();
+}
+
+void PathfinderCache::invalidatePaths(const CGHeroInstance * hero)
+{
+	boost::unique_lock<boost::mutex> lock(pathsMutex);
+	paths.erase(hero);
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,62 @@
+/*
+ * PathfinderCache.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class CGameInfoCallback;
+class CGHeroInstance;
+struct CPathsInfo;
+
+/// Keeps calculated paths of heroes between requests
+/// Paths of a hero are reused for as long as state of the hero that affects pathfinding (position,
+/// movement points, mana, bonuses) is unchanged. Changes of the map itself, such as objects appearing,
+/// moving or disappearing, or fog of war being revealed, must be reported via invalidatePaths()
+class DLL_LINKAGE PathfinderCache
+{
+	struct HeroState
+	{
+		int3 position;
+		int movementPoints = 0;
+		int mana = 0;
+		bool inBoat = false;
+		int64_t bonusesVersion = 0;
+
+		explicit HeroState(const CGHeroInstance * hero);
+		bool operator==(const HeroState & other) const;
+	};
+
+	struct CachedPaths
+	{
+		HeroState state;
+		std::shared_ptr<const CPathsInfo> paths;
+	};
+
+	CGameInfoCallback * cb;
+	std::map<const CGHeroInstance *, CachedPaths> paths;
+	boost::mutex pathsMutex;
+
+public:
+	explicit PathfinderCache(CGameInfoCallback * cb);
+
+	/// Returns paths of hero, recalculating them only if hero has changed since last request
+	std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * hero);
+	/// Returns paths of multiple heroes of the same player, outdated paths are recalculated in one batch
+	std::vector<std::shared_ptr<const CPathsInfo>> getPathsInfo(const std::vector<const CGHeroInstance *> & heroes);
+
+	/// Drops paths of all heroes, e.g. due to change of map objects or fog of war
+	void invalidatePaths();
+	/// Drops paths of specific hero, e.g. due to change of its army or artifacts that is not visible in its state
+	void invalidatePaths(const CGHeroInstance * hero);
+};
+
+VCMI_LIB_NAMESPACE_END
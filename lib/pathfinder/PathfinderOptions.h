@@ -19,6 +19,7 @@ class CGHeroInstance;
 class CGameInfoCallback;
 struct PathNodeInfo;
 struct CPathsInfo;
+class PlayerTileAccessibility;
 
 struct DLL_LINKAGE PathfinderOptions
 {
@@ -110,7 +111,7 @@ private:
 	std::unique_ptr<CPathfinderHelper> pathfinderHelper;
 
 public:
-	SingleHeroPathfinderConfig(CPathsInfo & out, CGameState * gs, const CGHeroInstance * hero);
+	SingleHeroPathfinderConfig(CPathsInfo & out, CGameState * gs, const CGHeroInstance * hero, std::shared_ptr<const PlayerTileAccessibility> accessibility = nullptr);
 	virtual ~SingleHeroPathfinderConfig();
 
 	CPathfinderHelper * getOrCreatePathfinderHelper(const PathNodeInfo & source, CGameState * gs) override;
@@ -0,0 +1,162 @@
+/*
+ * BinaryDelta.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BinaryDelta.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+namespace
+{
+
+/// Size of blocks of base data that can be referenced by delta. Smaller blocks find more matches but take more memory
+constexpr size_t blockSize = 32;
+constexpr uint32_t hashMultiplier = 0x01000193;
+
+uint32_t blockHash(const std::byte * data)
+{
+	uint32_t hash = 0;
+	for(size_t i = 0; i < blockSize; ++i)
+		hash = hash * hashMultiplier + std::to_integer<uint32_t>(data[i]);
+	return hash;
+}
+
+void writeVarInt(std::vector<std::byte> & out, uint64_t value)
+{
+	while(value >= 0x80)
+	{
+		out.push_back(static_cast<std::byte>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<std::byte>(value));
+}
+
+uint64_t readVarInt(const std::vector<std::byte> & in, size_t & position)
+{
+	uint64_t value = 0;
+	for(int shift = 0; shift < 64; shift += 7)
+	{
+		if(position >= in.size())
+			throw std::runtime_error("Malformed binary delta: unexpected end of data!");
+
+		auto byte = std::to_integer<uint64_t>(in[position++]);
+		value |= (byte & 0x7f) << shift;
+		if((byte & 0x80) == 0)
+			return value;
+	}
+	throw std::runtime_error("Malformed binary delta: invalid integer!");
+}
+
+/// Writes single operation: literal data from target, followed by copy of range from base
+void writeOperation(std::vector<std::byte> & out, const std::byte * literal, size_t literalSize, size_t copyOffset, size_t copySize)
+{
+	writeVarInt(out, literalSize);
+	out.insert(out.end(), literal, literal + literalSize);
+	writeVarInt(out, copySize);
+	if(copySize != 0)
+		writeVarInt(out, copyOffset);
+}
+
+}
+
+std::vector<std::byte> BinaryDelta::encode(const std::vector<std::byte> & base, const std::vector<std::byte> & target)
+{
+	std::vector<std::byte> result;
+
+	if(base.size() < blockSize || target.size() < blockSize)
+	{
+		writeOperation(result, target.data(), target.size(), 0, 0);
+		return result;
+	}
+
+	// index all aligned blocks of base data, in case of collisions first block is used
+	std::unordered_map<uint32_t, uint32_t> blocks;
+	blocks.reserve(base.size() / blockSize);
+	for(size_t offset = 0; offset + blockSize <= base.size(); offset += blockSize)
+		blocks.emplace(blockHash(base.data() + offset), offset);
+
+	// multiplier of byte that leaves rolling window
+	uint32_t outgoingMultiplier = 1;
+	for(size_t i = 1; i < blockSize; ++i)
+		outgoingMultiplier *= hashMultiplier;
+
+	size_t literalStart = 0;
+	size_t position = 0;
+	uint32_t hash = blockHash(target.data());
+
+	while(position + blockSize <= target.size())
+	{
+		auto it = blocks.find(hash);
+		if(it != blocks.end() && std::memcmp(base.data() + it->second, target.data() + position, blockSize) == 0)
+		{
+			size_t baseOffset = it->second;
+			size_t matchSize = blockSize;
+
+			while(position + matchSize < target.size() && baseOffset + matchSize < base.size() && target[position + matchSize] == base[baseOffset + matchSize])
+				++matchSize;
+
+			while(position > literalStart && baseOffset > 0 && target[position - 1] == base[baseOffset - 1])
+			{
+				--position;
+				--baseOffset;
+				++matchSize;
+			}
+
+			writeOperation(result, target.data() + literalStart, position - literalStart, baseOffset, matchSize);
+
+			position += matchSize;
+			literalStart = position;
+			if(position + blockSize <= target.size())
+				hash = blockHash(target.data() + position);
+			continue;
+		}
+
+		if(position + blockSize < target.size())
+		{
+			hash -= std::to_integer<uint32_t>(target[position]) * outgoingMultiplier;
+			hash = hash * hashMultiplier + std::to_integer<uint32_t>(target[position + blockSize]);
+		}
+		++position;
+	}
+
+	if(literalStart != target.size())
+		writeOperation(result, target.data() + literalStart, target.size() - literalStart, 0, 0);
+
+	return result;
+}
+
+std::vector<std::byte> BinaryDelta::decode(const std::vector<std::byte> & base, const std::vector<std::byte> & delta)
+{
+	std::vector<std::byte> result;
+	size_t position = 0;
+
+	while(position < delta.size())
+	{
+		uint64_t literalSize = readVarInt(delta, position);
+		if(literalSize > delta.size() - position)
+			throw std::runtime_error("Malformed binary delta: literal is out of bounds!");
+
+		result.insert(result.end(), delta.begin() + position, delta.begin() + position + literalSize);
+		position += literalSize;
+
+		uint64_t copySize = readVarInt(delta, position);
+		if(copySize == 0)
+			continue;
+
+		uint64_t copyOffset = readVarInt(delta, position);
+		if(copyOffset > base.size() || copySize > base.size() - copyOffset)
+			throw std::runtime_error("Malformed binary delta: copied range is out of bounds!");
+
+		result.insert(result.end(), base.begin() + copyOffset, base.begin() + copyOffset + copySize);
+	}
+
+	return result;
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,25 @@
+/*
+ * BinaryDelta.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Binary difference between two byte sequences, e.g. two consecutive serialized game states
+/// Delta consists of operations that insert new data or copy range of base data
+namespace BinaryDelta
+{
+	/// Returns delta that allows to reconstruct target from base
+	DLL_LINKAGE std::vector<std::byte> encode(const std::vector<std::byte> & base, const std::vector<std::byte> & target);
+
+	/// Reconstructs target from base and delta produced by encode. Throws on malformed delta
+	DLL_LINKAGE std::vector<std::byte> decode(const std::vector<std::byte> & base, const std::vector<std::byte> & delta);
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -12,6 +12,8 @@
 #include "CSerializer.h"
 #include "SerializerReflection.h"
 #include "ESerializationVersion.h"
+#include "SerializationStatistics.h"
+#include "../ScopeGuard.h"
 #include "../mapObjects/CGHeroInstance.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -21,6 +23,9 @@ class DLL_LINKAGE CLoaderBase
 protected:
 	IBinaryReader * reader;
 public:
+	/// Total number of bytes read by this deserializer
+	uint64_t bytesRead = 0;
+
 	CLoaderBase(IBinaryReader * r): reader(r){};
 
 	inline void read(void * data, unsigned size, bool reverseEndianness)
@@ -28,6 +33,7 @@ public:
 		auto bytePtr = reinterpret_cast<std::byte*>(data);
 
 		reader->read(bytePtr, size);
+		bytesRead += size;
 		if(reverseEndianness)
 			std::reverse(bytePtr, bytePtr + size);
 	};
@@ -105,6 +111,9 @@ public:
 	static constexpr bool saving = false;
 	bool loadingGamestate = false;
 
+	/// If set, collects size and deserialization time of every loaded polymorphic type
+	SerializationStatistics * statistics = nullptr;
+
 	bool hasFeature(Version what) const
 	{
 		return version >= what;
@@ -146,6 +155,34 @@ public:
 		}
 	}
 
+	/// Returns true if serialized form of T is identical to its in-memory representation
+	template<typename T>
+	bool isBulkSerializable() const
+	{
+		if constexpr (std::is_same_v<T, bool>)
+			return false;
+		else if constexpr (std::is_floating_point_v<T>)
+			return !reverseEndianness;
+		else if constexpr (std::is_integral_v<T>)
+			return sizeof(T) == 1 || (!reverseEndianness && !hasFeature(Version::COMPACT_INTEGER_SERIALIZATION));
+		else
+			return false;
+	}
+
+	/// Loads contiguous range of elements, primitive types are read as single block
+	template<typename T>
+	void loadRange(T * data, size_t count)
+	{
+		if (isBulkSerializable<T>())
+		{
+			this->read(static_cast<void *>(data), sizeof(T) * count, false);
+			return;
+		}
+
+		for(size_t i = 0; i < count; i++)
+			load(data[i]);
+	}
+
 	template < class T, typename std::enable_if_t < std::is_floating_point_v<T>, int  > = 0 >
 	void load(T &data)
 	{
@@ -211,8 +248,7 @@ public:
 	{
 		uint32_t length = readAndCheckLength();
 		data.resize(length);
-		for(uint32_t i=0;i<length;i++)
-			load( data[i]);
+		loadRange(data.data(), length);
 	}
 
 	template <typename T, typename std::enable_if_t < !std::is_same_v<T, bool >, int  > = 0>
@@ -316,6 +352,17 @@ public:
 			auto dataNonConst = dynamic_cast<ncpT*>(app->createPtr(*this, cb));
 			data = dataNonConst;
 			ptrAllocated(data, pid);
+
+			if(statistics)
+				statistics->beginType(tid, typeid(*dataNonConst), bytesRead);
+
+			// type must leave stack of statistics even if serialization throws
+			auto statisticsGuard = vstd::makeScopeGuard([this]()
+			{
+				if(statistics)
+					statistics->endType(bytesRead);
+			});
+
 			app->loadPtr(*this, cb, dataNonConst);
 		}
 	}
@@ -381,8 +428,7 @@ public:
 	template <typename T, size_t N>
 	void load(std::array<T, N> &data)
 	{
-		for(uint32_t i = 0; i < N; i++)
-			load( data[i] );
+		loadRange(data.data(), N);
 	}
 	template <typename T>
 	void load(std::set<T> &data)
@@ -528,8 +574,7 @@ public:
 		load(z);
 		data.resize(boost::extents[x][y][z]);
 		assert(length == data.num_elements()); //x*y*z should be equal to number of elements
-		for(uint32_t i = 0; i < length; i++)
-			load(data.data()[i]);
+		loadRange(data.data(), length);
 	}
 	template <std::size_t T>
 	void load(std::bitset<T> &data)
@@ -14,6 +14,8 @@
 #include "SerializerReflection.h"
 #include "ESerializationVersion.h"
 #include "Serializeable.h"
+#include "SerializationStatistics.h"
+#include "../ScopeGuard.h"
 #include "../mapObjects/CArmedInstance.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -23,11 +25,15 @@ class DLL_LINKAGE CSaverBase
 protected:
 	IBinaryWriter * writer;
 public:
+	/// Total number of bytes written by this serializer
+	uint64_t bytesWritten = 0;
+
 	CSaverBase(IBinaryWriter * w): writer(w){};
 
 	void write(const void * data, unsigned size)
 	{
 		writer->write(reinterpret_cast<const std::byte*>(data), size);
+		bytesWritten += size;
 	};
 };
 
@@ -92,6 +98,9 @@ public:
 	static constexpr bool saving = true;
 	bool loadingGamestate = false;
 
+	/// If set, collects size and serialization time of every saved polymorphic type
+	SerializationStatistics * statistics = nullptr;
+
 	bool hasFeature(Version what) const
 	{
 		return version >= what;
@@ -106,22 +115,81 @@ public:
 		return * this;
 	}
 
-	void saveEncodedInteger(int64_t value)
+	/// Maximal size of single integer in compact form: 6 bits of last byte + 7 bits of each other byte
+	static constexpr size_t maxEncodedIntegerSize = 10;
+
+	/// Writes integer in compact form into provided buffer, returns number of used bytes
+	static size_t encodeInteger(int64_t value, uint8_t * output)
 	{
 		uint64_t valueUnsigned = std::abs(value);
+		size_t size = 0;
 
 		while (valueUnsigned > 0x3f)
 		{
-			uint8_t byteValue = (valueUnsigned & 0x7f) | 0x80;
+			output[size++] = (valueUnsigned & 0x7f) | 0x80;
 			valueUnsigned = valueUnsigned >> 7;
-			save(byteValue);
 		}
 
 		uint8_t lastByteValue = valueUnsigned & 0x3f;
 		if (value < 0)
 			lastByteValue |= 0x40;
 
-		save(lastByteValue);
+		output[size++] = lastByteValue;
+		return size;
+	}
+
+	void saveEncodedInteger(int64_t value)
+	{
+		std::array<uint8_t, maxEncodedIntegerSize> encoded;
+		size_t size = encodeInteger(value, encoded.data());
+		this->write(encoded.data(), size);
+	}
+
+	/// Returns true if serialized form of T is identical to its in-memory representation
+	template<typename T>
+	bool isBulkSerializable() const
+	{
+		if constexpr (std::is_same_v<T, bool>)
+			return false;
+		else if constexpr (std::is_floating_point_v<T>)
+			return true;
+		else if constexpr (std::is_integral_v<T>)
+			return sizeof(T) == 1 || !hasFeature(Version::COMPACT_INTEGER_SERIALIZATION);
+		else
+			return false;
+	}
+
+	/// Saves contiguous range of elements. Primitive types are written as single block
+	/// instead of element-by-element, serialized form is identical in both cases
+	template<typename T>
+	void saveRange(const T * data, size_t count)
+	{
+		if (isBulkSerializable<T>())
+		{
+			this->write(static_cast<const void *>(data), sizeof(T) * count);
+			return;
+		}
+
+		if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+		{
+			// encode integers in chunks to avoid passing every single byte to writer
+			constexpr size_t chunkSize = 256;
+			std::array<uint8_t, chunkSize * maxEncodedIntegerSize> encoded;
+
+			for(size_t chunkBegin = 0; chunkBegin < count; chunkBegin += chunkSize)
+			{
+				size_t chunkEnd = std::min(count, chunkBegin + chunkSize);
+				size_t size = 0;
+				for(size_t i = chunkBegin; i < chunkEnd; i++)
+					size += encodeInteger(data[i], encoded.data() + size);
+				this->write(encoded.data(), size);
+			}
+		}
+		else
+		{
+			for(size_t i = 0; i < count; i++)
+				save(data[i]);
+		}
 	}
 
 	template < typename T, typename std::enable_if_t < std::is_same_v<T, bool>, int > = 0 >
@@ -246,9 +314,23 @@ public:
 		save(tid);
 
 		if(!tid)
+		{
 			save(*data); //if type is unregistered simply write all data in a standard way
+		}
 		else
+		{
+			if(statistics)
+				statistics->beginType(tid, typeid(*data), bytesWritten);
+
+			// type must leave stack of statistics even if serialization throws
+			auto statisticsGuard = vstd::makeScopeGuard([this]()
+			{
+				if(statistics)
+					statistics->endType(bytesWritten);
+			});
+
 			CSerializationApplier::getInstance().getApplier(tid)->savePtr(*this, static_cast<const Serializeable*>(data));  //call serializer specific for our real type
+		}
 	}
 
 	template < typename T, typename std::enable_if_t < is_serializeable<BinarySerializer, T>::value, int  > = 0 >
@@ -285,8 +367,7 @@ public:
 	{
 		uint32_t length = data.size();
 		*this & length;
-		for(uint32_t i=0;i<length;i++)
-			save(data[i]);
+		saveRange(data.data(), length);
 	}
 	template <typename T, typename std::enable_if_t < !std::is_same_v<T, bool >, int  > = 0>
 	void save(const std::deque<T> & data)
@@ -299,8 +380,7 @@ public:
 	template <typename T, size_t N>
 	void save(const std::array<T, N> &data)
 	{
-		for(uint32_t i=0; i < N; i++)
-			save(data[i]);
+		saveRange(data.data(), N);
 	}
 	template <typename T>
 	void save(const std::set<T> &data)
@@ -434,8 +514,7 @@ public:
 		uint32_t y = shape[1];
 		uint32_t z = shape[2];
 		*this & x & y & z;
-		for(uint32_t i = 0; i < length; i++)
-			save(data.data()[i]);
+		saveRange(data.data(), length);
 	}
 	template <std::size_t T>
 	void save(const std::bitset<T> &data)
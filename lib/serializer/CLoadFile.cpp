@@ -10,6 +10,12 @@
 #include "StdInc.h"
 #include "CLoadFile.h"
 
+#include "BinaryDelta.h"
+#include "CSerializer.h"
+#include "../filesystem/CCompressedStream.h"
+#include "../filesystem/CFileInputStream.h"
+#include "../filesystem/CMemoryStream.h"
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 CLoadFile::CLoadFile(const boost::filesystem::path & fname, ESerializationVersion minimalVersion)
@@ -23,6 +29,16 @@ CLoadFile::~CLoadFile() = default;
 
 int CLoadFile::read(std::byte * data, unsigned size)
 {
+	if(dataStream)
+	{
+		// only header of delta save is available so far - reading past it requires reconstruction from keyframe
+		if(!pendingKeyframe.empty() && dataStream->tell() + size > dataStream->getSize())
+			reconstructDeltaData();
+
+		readFromStream(data, size);
+		return size;
+	}
+
 	sfile->read(reinterpret_cast<char *>(data), size);
 	return size;
 }
@@ -35,6 +51,10 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 
 	try
 	{
+		// data stream of previously opened file, if any, must not be reused
+		dataStream = nullptr;
+		pendingKeyframe.clear();
+
 		fName = fname.string();
 		sfile = std::make_unique<std::fstream>(fname.c_str(), std::ios::in | std::ios::binary);
 		sfile->exceptions(std::ifstream::failbit | std::ifstream::badbit); //we throw a lot anyway
@@ -68,6 +88,16 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 			else
 				THROW_FORMAT("Error: too new file format (%s)!", fName);
 		}
+
+		if(serializer.version >= ESerializationVersion::DELTA_AUTOSAVES)
+			readFileKind(fname);
+
+		if(!dataStream && serializer.version >= ESerializationVersion::COMPRESSED_SAVES)
+		{
+			// data is decompressed on demand, so loading can start before whole file has been read
+			auto dataStart = static_cast<si64>(sfile->tellg());
+			dataStream = std::make_unique<CCompressedStream>(std::make_unique<CFileInputStream>(fname, dataStart), false);
+		}
 	}
 	catch(...)
 	{
@@ -76,15 +106,109 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 	}
 }
 
+void CLoadFile::readFileKind(const boost::filesystem::path & fname)
+{
+	ESaveFileKind kind;
+	sfile->read(reinterpret_cast<char *>(&kind), sizeof(kind));
+
+	if(kind == ESaveFileKind::FULL)
+		return;
+
+	if(kind != ESaveFileKind::DELTA)
+		THROW_FORMAT("Error: unknown save file kind (%s)!", fName);
+
+	uint8_t nameLength;
+	sfile->read(reinterpret_cast<char *>(&nameLength), sizeof(nameLength));
+	std::string keyframeName(nameLength, '\0');
+	sfile->read(keyframeName.data(), nameLength);
+
+	// header is stored uncompressed, so save game can be previewed without touching keyframe, or even if keyframe is gone
+	uint32_t headerSize;
+	sfile->read(reinterpret_cast<char *>(&headerSize), sizeof(headerSize));
+	reconstructedData.resize(headerSize);
+	sfile->read(reinterpret_cast<char *>(reconstructedData.data()), headerSize);
+
+	pendingKeyframe = fname.parent_path() / keyframeName;
+	deltaStart = static_cast<si64>(sfile->tellg());
+	dataStream = std::make_unique<CMemoryStream>(reinterpret_cast<const ui8 *>(reconstructedData.data()), reconstructedData.size());
+}
+
+void CLoadFile::reconstructDeltaData()
+{
+	auto position = dataStream->tell();
+
+	if(!boost::filesystem::exists(pendingKeyframe))
+		throw MissingKeyframeException(pendingKeyframe.filename().string(), fName);
+
+	CLoadFile keyframe(pendingKeyframe, serializer.version);
+	if(keyframe.serializer.version != serializer.version)
+		THROW_FORMAT("Error: keyframe %s has different format than save %s!", pendingKeyframe.filename().string() % fName);
+
+	auto keyframeData = keyframe.readRemainingData();
+
+	dataStream = std::make_unique<CCompressedStream>(std::make_unique<CFileInputStream>(fName, deltaStart), false);
+	auto delta = readRemainingData();
+
+	reconstructedData = BinaryDelta::decode(keyframeData, delta);
+	dataStream = std::make_unique<CMemoryStream>(reinterpret_cast<const ui8 *>(reconstructedData.data()), reconstructedData.size());
+	dataStream->seek(position);
+	pendingKeyframe.clear();
+}
+
+std::vector<std::byte> CLoadFile::readRemainingData()
+{
+	std::vector<std::byte> result(dataStream->getSize() - dataStream->tell());
+	readFromStream(result.data(), result.size());
+	return result;
+}
+
+void CLoadFile::readFromStream(std::byte * data, si64 size)
+{
+	// buffered streams report requested size even on short read, so check how far the stream has actually advanced
+	si64 start = dataStream->tell();
+	dataStream->read(reinterpret_cast<ui8 *>(data), size);
+	if(dataStream->tell() - start != size)
+		THROW_FORMAT("Error: unexpected end of file (%s)!", fName);
+}
+
+std::string CLoadFile::getKeyframeName(const boost::filesystem::path & fname)
+{
+	std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+	file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+	char magic[4];
+	ESerializationVersion version;
+	ESaveFileKind kind;
+
+	file.read(magic, 4);
+	file.read(reinterpret_cast<char *>(&version), sizeof(version));
+	if(std::memcmp(magic, "VCMI", 4) != 0 || version < ESerializationVersion::DELTA_AUTOSAVES || version > ESerializationVersion::CURRENT)
+		return {};
+
+	file.read(reinterpret_cast<char *>(&kind), sizeof(kind));
+	if(kind != ESaveFileKind::DELTA)
+		return {};
+
+	uint8_t nameLength;
+	file.read(reinterpret_cast<char *>(&nameLength), sizeof(nameLength));
+	std::string keyframeName(nameLength, '\0');
+	file.read(keyframeName.data(), nameLength);
+	return keyframeName;
+}
+
 void CLoadFile::reportState(vstd::CLoggerBase * out)
 {
 	out->debug("CLoadFile");
-	if(!!sfile && *sfile)
+	if(dataStream)
+		out->debug("\tOpened %s Decompressed position: %d", fName, dataStream->tell());
+	else if(!!sfile && *sfile)
 		out->debug("\tOpened %s Position: %d", fName, sfile->tellg());
 }
 
 void CLoadFile::clear()
 {
+	dataStream = nullptr;
+	pendingKeyframe.clear();
 	sfile = nullptr;
 	fName.clear();
 	serializer.version = ESerializationVersion::NONE;
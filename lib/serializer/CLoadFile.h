@@ -13,13 +13,41 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+class CInputStream;
+
+/// Thrown when data of delta save is requested but keyframe that it depends on no longer exists
+class MissingKeyframeException : public std::runtime_error
+{
+public:
+	const std::string keyframeName;
+
+	MissingKeyframeException(const std::string & keyframeName, const std::string & saveName)
+		: std::runtime_error("Missing keyframe " + keyframeName + " of save " + saveName)
+		, keyframeName(keyframeName)
+	{}
+};
+
 class DLL_LINKAGE CLoadFile : public IBinaryReader
 {
+	void readFileKind(const boost::filesystem::path & fname);
+	void reconstructDeltaData();
+	std::vector<std::byte> readRemainingData();
+	void readFromStream(std::byte * data, si64 size);
+
+	/// Keyframe of delta save, set until data beyond uncompressed header of delta save has been requested
+	boost::filesystem::path pendingKeyframe;
+	/// Position of compressed delta in file
+	si64 deltaStart = 0;
+
 public:
 	BinaryDeserializer serializer;
 
 	std::string fName;
 	std::unique_ptr<std::fstream> sfile;
+	/// Stream for data after file header, used by save games that were written in compressed or delta format
+	std::unique_ptr<CInputStream> dataStream;
+	/// Serialized data reconstructed from delta save and its keyframe, or only its header if rest was not read yet
+	std::vector<std::byte> reconstructedData;
 
 	CLoadFile(const boost::filesystem::path & fname, ESerializationVersion minimalVersion = ESerializationVersion::CURRENT); //throws!
 	virtual ~CLoadFile();
@@ -31,6 +59,9 @@ public:
 
 	void checkMagicBytes(const std::string & text);
 
+	/// Returns name of keyframe file that specified save game depends on, or empty string if save is not stored as delta
+	static std::string getKeyframeName(const boost::filesystem::path & fname); //throws!
+
 	template<class T>
 	CLoadFile & operator>>(T &t)
 	{
@@ -24,15 +24,32 @@ int CMemorySerializer::read(std::byte * data, unsigned size)
 
 int CMemorySerializer::write(const std::byte * data, unsigned size)
 {
-	auto oldSize = buffer.size(); //and the pos to write from
-	buffer.resize(oldSize + size);
-	std::copy_n(data, size, buffer.data() + oldSize);
+	buffer.insert(buffer.end(), data, data + size);
 	return size;
 }
 
+/// Buffer that was used by most recently destroyed serializer of this thread
+static std::vector<std::byte> & getSpareBuffer()
+{
+	static thread_local std::vector<std::byte> spareBuffer;
+	return spareBuffer;
+}
+
+/// Buffers larger than this are released instead of being kept for reuse
+static constexpr size_t maxSpareBufferSize = 4 * 1024 * 1024;
+
 CMemorySerializer::CMemorySerializer(): iser(this), oser(this), readPos(0)
 {
 	iser.version = ESerializationVersion::CURRENT;
+	buffer.swap(getSpareBuffer());
+	buffer.clear();
+}
+
+CMemorySerializer::~CMemorySerializer()
+{
+	auto & spareBuffer = getSpareBuffer();
+	if(buffer.capacity() > spareBuffer.capacity() && buffer.capacity() <= maxSpareBufferSize)
+		spareBuffer.swap(buffer);
 }
 
 VCMI_LIB_NAMESPACE_END
@@ -15,12 +15,20 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 /// Serializer that stores objects in the dynamic buffer. Allows performing deep object copies.
+/// Memory of the buffer is reused by subsequent serializers created by the same thread
 class DLL_LINKAGE CMemorySerializer
 	: public IBinaryReader, public IBinaryWriter
 {
 	std::vector<std::byte> buffer;
 
 	size_t readPos; //index of the next byte to be read
+
+	template<typename T, typename = void>
+	struct HasClone : std::false_type {};
+
+	template<typename T>
+	struct HasClone<T, std::void_t<decltype(std::declval<const T &>().clone())>> : std::is_same<decltype(std::declval<const T &>().clone()), std::unique_ptr<T>> {};
+
 public:
 	BinaryDeserializer iser;
 	BinarySerializer oser;
@@ -29,16 +37,28 @@ public:
 	int write(const std::byte * data, unsigned size) override;
 
 	CMemorySerializer();
+	~CMemorySerializer();
 
+	/// Creates independent copy of object, including all objects that it owns
+	/// Types that provide "std::unique_ptr<T> clone() const" method are copied using it,
+	/// without serialization round trip
 	template <typename T>
 	static std::unique_ptr<T> deepCopy(const T &data)
 	{
-		CMemorySerializer mem;
-		mem.oser & &data;
+		if constexpr (HasClone<T>::value)
+		{
+			assert(typeid(data) == typeid(T)); // clone of derived type would lose its data
+			return data.clone();
+		}
+		else
+		{
+			CMemorySerializer mem;
+			mem.oser & &data;
 
-		std::unique_ptr<T> ret;
-		mem.iser & ret;
-		return ret;
+			std::unique_ptr<T> ret;
+			mem.iser & ret;
+			return ret;
+		}
 	}
 };
 
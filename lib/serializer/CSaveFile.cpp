@@ -10,12 +10,21 @@
 #include "StdInc.h"
 #include "CSaveFile.h"
 
+#include "BinaryDelta.h"
+#include "CSerializer.h"
+#include "../ScopeGuard.h"
+
+#include <zlib.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Amount of serialized data that is passed to compressor at once
+static constexpr size_t compressionChunkSize = 1024 * 1024;
+
 CSaveFile::CSaveFile(const boost::filesystem::path &fname)
 	: serializer(this)
+	, fName(fname)
 {
-	openNextFile(fname);
 }
 
 //must be instantiated in .cpp file for access to complete types of all member fields
@@ -23,45 +32,113 @@ CSaveFile::~CSaveFile() = default;
 
 int CSaveFile::write(const std::byte * data, unsigned size)
 {
-	sfile->write(reinterpret_cast<const char *>(data), size);
+	buffer.insert(buffer.end(), data, data + size);
 	return size;
 }
 
-void CSaveFile::openNextFile(const boost::filesystem::path &fname)
+void CSaveFile::writeToDisk() const
+{
+	writeFile(fName, nullptr);
+}
+
+void CSaveFile::writeDeltaToDisk(const boost::filesystem::path & path, const CSaveFile & keyframe) const
+{
+	writeFile(path, &keyframe);
+}
+
+void CSaveFile::writeFile(const boost::filesystem::path & path, const CSaveFile * keyframe) const
 {
-	fName = fname;
+	// unique name, so several processes writing the same file never write into the same temporary file
+	boost::filesystem::path tempName = path;
+	tempName += boost::filesystem::unique_path(".%%%%-%%%%-%%%%.tmp");
+
 	try
 	{
-		sfile = std::make_unique<std::fstream>(fname.c_str(), std::ios::out | std::ios::binary);
-		sfile->exceptions(std::ifstream::failbit | std::ifstream::badbit); //we throw a lot anyway
+		{
+			std::ofstream file(tempName.c_str(), std::ios::out | std::ios::binary);
+			file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+			auto version = ESerializationVersion::CURRENT;
+			auto kind = keyframe ? ESaveFileKind::DELTA : ESaveFileKind::FULL;
+
+			file.write("VCMI", 4); //write magic identifier
+			file.write(reinterpret_cast<const char *>(&version), sizeof(version)); //write format version
+			file.write(reinterpret_cast<const char *>(&kind), sizeof(kind));
 
-		if(!(*sfile))
-			THROW_FORMAT("Error: cannot open to write %s!", fname);
+			if (keyframe)
+			{
+				std::string keyframeName = keyframe->fName.filename().string();
+				auto nameLength = static_cast<uint8_t>(keyframeName.size());
+				if (nameLength != keyframeName.size())
+					throw std::runtime_error("Keyframe file name is too long!");
 
-		sfile->write("VCMI",4); //write magic identifier
-		serializer & ESerializationVersion::CURRENT; //write format version
+				file.write(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+				file.write(keyframeName.data(), nameLength);
+
+				auto storedHeaderSize = static_cast<uint32_t>(headerSize);
+				file.write(reinterpret_cast<const char *>(&storedHeaderSize), sizeof(storedHeaderSize));
+				file.write(reinterpret_cast<const char *>(buffer.data()), headerSize);
+				writeCompressed(file, BinaryDelta::encode(keyframe->buffer, buffer));
+			}
+			else
+				writeCompressed(file, buffer);
+		}
+		boost::filesystem::rename(tempName, path);
 	}
 	catch(...)
 	{
-		logGlobal->error("Failed to save to %s", fname.string());
-		clear();
+		logGlobal->error("Failed to save to %s", path.string());
+		boost::system::error_code ec;
+		boost::filesystem::remove(tempName, ec);
 		throw;
 	}
 }
 
-void CSaveFile::reportState(vstd::CLoggerBase * out)
+void CSaveFile::writeCompressed(std::ostream & file, const std::vector<std::byte> & data)
 {
-	out->debug("CSaveFile");
-	if(sfile.get() && *sfile)
+	z_stream deflateState = {};
+
+	if (deflateInit(&deflateState, Z_DEFAULT_COMPRESSION) != Z_OK)
+		throw std::runtime_error("Failed to initialize deflate!");
+
+	auto guard = vstd::makeScopeGuard([&deflateState]()
 	{
-		out->debug("\tOpened %s \tPosition: %d", fName, sfile->tellp());
+		deflateEnd(&deflateState);
+	});
+
+	std::vector<Bytef> output(compressionChunkSize);
+	size_t position = 0;
+	int result;
+
+	// feed serialized data to compressor chunk by chunk, writing compressed data as soon as it becomes available
+	do
+	{
+		size_t chunkSize = std::min(compressionChunkSize, data.size() - position);
+		bool lastChunk = position + chunkSize == data.size();
+
+		deflateState.next_in = reinterpret_cast<Bytef *>(const_cast<std::byte *>(data.data() + position));
+		deflateState.avail_in = static_cast<uInt>(chunkSize);
+		position += chunkSize;
+
+		do
+		{
+			deflateState.next_out = output.data();
+			deflateState.avail_out = static_cast<uInt>(output.size());
+
+			result = deflate(&deflateState, lastChunk ? Z_FINISH : Z_NO_FLUSH);
+			if (result == Z_STREAM_ERROR)
+				throw std::runtime_error("Failed to compress save game!");
+
+			file.write(reinterpret_cast<const char *>(output.data()), output.size() - deflateState.avail_out);
+		}
+		while (deflateState.avail_out == 0);
 	}
+	while (result != Z_STREAM_END);
 }
 
-void CSaveFile::clear()
+void CSaveFile::reportState(vstd::CLoggerBase * out)
 {
-	fName.clear();
-	sfile = nullptr;
+	out->debug("CSaveFile");
+	out->debug("\tFile %s \tSerialized: %d bytes", fName, buffer.size());
 }
 
 void CSaveFile::putMagicBytes(const std::string &text)
@@ -69,4 +146,9 @@ void CSaveFile::putMagicBytes(const std::string &text)
 	write(reinterpret_cast<const std::byte*>(text.c_str()), text.length());
 }
 
+void CSaveFile::markHeaderEnd()
+{
+	headerSize = buffer.size();
+}
+
 VCMI_LIB_NAMESPACE_END
@@ -13,24 +13,44 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Serializes save game into memory buffer
+/// Serialized data is written to disk only on explicit request, which can be done by another thread,
+/// so game can continue while save is being written
 class DLL_LINKAGE CSaveFile : public IBinaryWriter
 {
+	/// Serialized data, without file header
+	std::vector<std::byte> buffer;
+	/// Size of leading part of serialized data that describes save game, such as map header
+	size_t headerSize = 0;
+
+	void writeFile(const boost::filesystem::path & path, const CSaveFile * keyframe) const;
+	static void writeCompressed(std::ostream & file, const std::vector<std::byte> & data);
+
 public:
 	BinarySerializer serializer;
 
 	boost::filesystem::path fName;
-	std::unique_ptr<std::fstream> sfile;
 
-	CSaveFile(const boost::filesystem::path &fname); //throws!
+	CSaveFile(const boost::filesystem::path &fname);
 	~CSaveFile();
 	int write(const std::byte * data, unsigned size) override;
 
-	void openNextFile(const boost::filesystem::path &fname); //throws!
-	void clear();
+	/// Compresses serialized data and writes it to disk. Data is written into temporary file first,
+	/// so partially written save game never replaces existing file
+	void writeToDisk() const; //throws!
+
+	/// Writes serialized data to specified file as difference to serialized data of keyframe save
+	/// Keyframe must be written to disk into the same directory and kept for as long as this file exists
+	void writeDeltaToDisk(const boost::filesystem::path & path, const CSaveFile & keyframe) const; //throws!
+
 	void reportState(vstd::CLoggerBase * out) override;
 
 	void putMagicBytes(const std::string &text);
 
+	/// Marks all data serialized so far as save game header
+	/// Delta saves store header uncompressed, so it can be read without reconstructing whole save from keyframe
+	void markHeaderEnd();
+
 	template<class T>
 	CSaveFile & operator<<(const T &t)
 	{
@@ -16,6 +16,13 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 const std::string SAVEGAME_MAGIC = "VCMISVG";
 
+/// Kind of save game file, stored right after file format version
+enum class ESaveFileKind : uint8_t
+{
+	FULL = 0, // file contains complete serialized data
+	DELTA = 1 // file contains difference to serialized data of keyframe file, located in the same directory
+};
+
 class CHero;
 class CGHeroInstance;
 class CGObjectInstance;
@@ -17,8 +17,18 @@
 #include "../networkPacks/NetPacksBase.h"
 #include "../network/NetworkInterface.h"
 
+#include <zlib.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
+// Every serialized pack begins with "is null" flag of pack pointer, which is always false (zero)
+// This allows receiver to detect compressed messages without any additional framing of uncompressed ones
+static constexpr std::byte compressedMessageMarker{0xFF};
+static constexpr size_t compressedMessageHeaderSize = 1 + sizeof(uint32_t);
+static constexpr size_t compressionThreshold = 64 * 1024;
+static constexpr size_t decompressedMessageMaxSize = 256 * 1024 * 1024; // prevents massive allocation if we receive garbage input
+static constexpr size_t packBatchMaxSize = 16 * 1024 * 1024; // batch is sent early once it grows past this size, well below network message size limit
+
 class DLL_LINKAGE ConnectionPackWriter final : public IBinaryWriter
 {
 public:
@@ -77,30 +87,150 @@ void CConnection::sendPack(const CPack & pack)
 	if (!connectionPtr)
 		throw std::runtime_error("Attempt to send packet on a closed connection!");
 
-	packWriter->buffer.clear();
+	// in batch mode packs are serialized back-to-back into the same buffer and sent once batch ends
+	if (packBatchDepth == 0)
+		packWriter->buffer.clear();
+
 	(*serializer) & (&pack);
 
 	logNetwork->trace("Sending a pack of type %s", typeid(pack).name());
 
-	connectionPtr->sendPacket(packWriter->buffer);
-	packWriter->buffer.clear();
 	serializer->savedPointers.clear();
+
+	if (packBatchDepth == 0 || packWriter->buffer.size() > packBatchMaxSize)
+	{
+		sendBuffer(*connectionPtr);
+		packWriter->buffer.clear();
+	}
+}
+
+void CConnection::beginPackBatch()
+{
+	boost::mutex::scoped_lock lock(writeMutex);
+
+	if (!packBatchingEnabled)
+		return;
+
+	if (packBatchDepth == 0)
+		packWriter->buffer.clear();
+	++packBatchDepth;
+}
+
+void CConnection::endPackBatch()
+{
+	boost::mutex::scoped_lock lock(writeMutex);
+
+	if (!packBatchingEnabled)
+		return;
+
+	assert(packBatchDepth > 0);
+	if (--packBatchDepth != 0)
+		return;
+
+	if (packWriter->buffer.empty())
+		return;
+
+	auto connectionPtr = networkConnection.lock();
+
+	// connection was closed while batch was active - nobody to send accumulated packs to
+	if (connectionPtr)
+		sendBuffer(*connectionPtr);
+	else
+		logNetwork->warn("Connection was closed before pack batch of %d bytes could be sent", packWriter->buffer.size());
+
+	packWriter->buffer.clear();
 }
 
-std::unique_ptr<CPack> CConnection::retrievePack(const std::vector<std::byte> & data)
+void CConnection::sendBuffer(INetworkConnection & connection)
+{
+	const auto & data = packWriter->buffer;
+
+	if (!compressionEnabled || data.size() < compressionThreshold)
+	{
+		connection.sendPacket(data);
+		return;
+	}
+
+	auto timeStart = std::chrono::steady_clock::now();
+
+	uint32_t uncompressedSize = data.size();
+	uLongf compressedSize = compressBound(data.size());
+	compressedBuffer.resize(compressedMessageHeaderSize + compressedSize);
+	compressedBuffer[0] = compressedMessageMarker;
+	std::memcpy(compressedBuffer.data() + 1, &uncompressedSize, sizeof(uncompressedSize));
+
+	int result = compress2(reinterpret_cast<Bytef *>(compressedBuffer.data() + compressedMessageHeaderSize), &compressedSize, reinterpret_cast<const Bytef *>(data.data()), data.size(), Z_BEST_SPEED);
+
+	if (result != Z_OK)
+	{
+		logNetwork->error("Failed to compress network message, error code %d! Sending it uncompressed", result);
+		connection.sendPacket(data);
+		return;
+	}
+
+	compressedBuffer.resize(compressedMessageHeaderSize + compressedSize);
+	connection.sendPacket(compressedBuffer);
+
+	auto timeSpent = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - timeStart);
+	logNetwork->info("Sent compressed message: %d bytes -> %d bytes (%.1f%%), took %d ms", data.size(), compressedBuffer.size(), 100.0 * compressedBuffer.size() / data.size(), timeSpent.count());
+}
+
+const std::vector<std::byte> & CConnection::unpackMessage(const std::vector<std::byte> & message)
+{
+	if (message.empty() || message[0] != compressedMessageMarker)
+		return message;
+
+	if (message.size() < compressedMessageHeaderSize)
+		throw std::runtime_error("Failed to unpack message! Compressed message is too short!");
+
+	auto timeStart = std::chrono::steady_clock::now();
+
+	uint32_t uncompressedSize;
+	std::memcpy(&uncompressedSize, message.data() + 1, sizeof(uncompressedSize));
+
+	if (uncompressedSize > decompressedMessageMaxSize)
+		throw std::runtime_error("Failed to unpack message! Invalid uncompressed size!");
+
+	decompressedBuffer.resize(uncompressedSize);
+	uLongf decompressedSize = uncompressedSize;
+
+	int result = uncompress(reinterpret_cast<Bytef *>(decompressedBuffer.data()), &decompressedSize, reinterpret_cast<const Bytef *>(message.data() + compressedMessageHeaderSize), message.size() - compressedMessageHeaderSize);
+
+	if (result != Z_OK || decompressedSize != uncompressedSize)
+		throw std::runtime_error("Failed to unpack message! Decompression error " + std::to_string(result));
+
+	auto timeSpent = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - timeStart);
+	logNetwork->info("Received compressed message: %d bytes -> %d bytes (%.1f%%), took %d ms", message.size(), decompressedBuffer.size(), 100.0 * message.size() / decompressedBuffer.size(), timeSpent.count());
+
+	return decompressedBuffer;
+}
+
+std::unique_ptr<CPack> CConnection::retrievePack(const std::vector<std::byte> & message)
+{
+	const auto & data = unpackMessage(message);
+
+	size_t position = 0;
+	auto result = retrievePack(data, position);
+
+	if (position != data.size())
+		throw std::runtime_error("Failed to retrieve pack! Not all data has been read!");
+
+	return result;
+}
+
+std::unique_ptr<CPack> CConnection::retrievePack(const std::vector<std::byte> & data, size_t & position)
 {
 	std::unique_ptr<CPack> result;
 
 	packReader->buffer = &data;
-	packReader->position = 0;
+	packReader->position = position;
 
 	*deserializer & result;
 
 	if (result == nullptr)
 		throw std::runtime_error("Failed to retrieve pack!");
 
-	if (packReader->position != data.size())
-		throw std::runtime_error("Failed to retrieve pack! Not all data has been read!");
+	position = packReader->position;
 
 	logNetwork->trace("Received CPack of type %s", typeid(result.get()).name());
 	deserializer->loadedPointers.clear();
@@ -169,4 +299,17 @@ void CConnection::setSerializationVersion(ESerializationVersion version)
 	serializer->version = version;
 }
 
+void CConnection::setCompressionEnabled(bool on)
+{
+	boost::mutex::scoped_lock lock(writeMutex);
+	compressionEnabled = on;
+}
+
+void CConnection::setPackBatchingEnabled(bool on)
+{
+	boost::mutex::scoped_lock lock(writeMutex);
+	assert(packBatchDepth == 0);
+	packBatchingEnabled = on;
+}
+
 VCMI_LIB_NAMESPACE_END
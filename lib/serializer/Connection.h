@@ -34,7 +34,16 @@ class DLL_LINKAGE CConnection : boost::noncopyable
 	std::unique_ptr<BinaryDeserializer> deserializer;
 	std::unique_ptr<BinarySerializer> serializer;
 
+	/// Buffers for compressed data of outgoing messages and decompressed data of incoming messages
+	std::vector<std::byte> compressedBuffer;
+	std::vector<std::byte> decompressedBuffer;
+
 	boost::mutex writeMutex;
+	int packBatchDepth = 0;
+	bool compressionEnabled = false;
+	bool packBatchingEnabled = false;
+
+	void sendBuffer(INetworkConnection & connection);
 
 	void disableStackSendingByID();
 	void enableStackSendingByID();
@@ -54,10 +63,31 @@ public:
 	void sendPack(const CPack & pack);
 	std::unique_ptr<CPack> retrievePack(const std::vector<std::byte> & data);
 
+	/// Returns packs data of received network message, decompressing it if necessary
+	/// Returned reference remains valid until next received message is unpacked
+	const std::vector<std::byte> & unpackMessage(const std::vector<std::byte> & message);
+
+	/// Retrieves pack that starts at specified position of unpacked message and advances position to next pack
+	/// Message may contain multiple packs if sender used pack batching
+	std::unique_ptr<CPack> retrievePack(const std::vector<std::byte> & data, size_t & position);
+
+	/// Packs sent between these calls are accumulated and sent to network as a single message
+	/// Batches may be nested, in which case message is sent once outermost batch ends
+	/// Large batches are split into several messages to stay within network message size limit
+	/// Does nothing unless pack batching was enabled for this connection
+	void beginPackBatch();
+	void endPackBatch();
+
 	void enterLobbyConnectionMode();
 	void setCallback(IGameCallback * cb);
 	void enterGameplayConnectionMode(CGameState * gs);
 	void setSerializationVersion(ESerializationVersion version);
+
+	/// Enables compression of large outgoing messages. Must only be enabled if remote side supports it
+	void setCompressionEnabled(bool on);
+
+	/// Enables sending of multiple packs in a single message. Must only be enabled if remote side supports it
+	void setPackBatchingEnabled(bool on);
 };
 
 VCMI_LIB_NAMESPACE_END
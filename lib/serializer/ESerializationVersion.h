@@ -65,6 +65,10 @@ enum class ESerializationVersion : int32_t
 	LOCAL_PLAYER_STATE_DATA, // 866 - player state contains arbitrary client-side data
 	REMOVE_TOWN_PTR, // 867 - removed pointer to CTown from CGTownInstance
 	REMOVE_OBJECT_TYPENAME, // 868 - remove typename from CGObjectInstance
+	NETWORK_COMPRESSION, // 869 - large network packs may be sent compressed
+	COMPRESSED_SAVES, // 870 - save game data after format version is compressed
+	DELTA_AUTOSAVES, // 871 - save game may be stored as difference to another save
+	PACK_BATCHING, // 872 - single network message may contain multiple packs
 
-	CURRENT = REMOVE_OBJECT_TYPENAME
+	CURRENT = PACK_BATCHING
 };
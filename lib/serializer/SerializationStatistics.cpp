@@ -0,0 +1,84 @@
+/*
+ * SerializationStatistics.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "SerializationStatistics.h"
+
+#include <boost/core/demangle.hpp>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+void SerializationStatistics::beginType(uint16_t typeID, const std::type_info & typeInfo, uint64_t position)
+{
+	auto & entry = types[typeID];
+	if(entry.name.empty())
+		entry.name = boost::core::demangle(typeInfo.name());
+
+	activeTypes.push_back({typeID, position, Clock::now(), 0, Clock::duration::zero()});
+}
+
+void SerializationStatistics::endType(uint64_t position)
+{
+	assert(!activeTypes.empty());
+
+	const auto active = activeTypes.back();
+	activeTypes.pop_back();
+
+	uint64_t totalBytes = position - active.startPosition;
+	Clock::duration totalTime = Clock::now() - active.startTime;
+
+	auto & entry = types[active.typeID];
+	entry.count += 1;
+	entry.bytes += totalBytes - active.nestedBytes;
+	entry.time += totalTime - active.nestedTime;
+
+	if(!activeTypes.empty())
+	{
+		activeTypes.back().nestedBytes += totalBytes;
+		activeTypes.back().nestedTime += totalTime;
+	}
+}
+
+void SerializationStatistics::clear()
+{
+	types.clear();
+	activeTypes.clear();
+}
+
+std::vector<SerializationStatistics::TypeStatistics> SerializationStatistics::getSortedStatistics() const
+{
+	std::vector<TypeStatistics> result;
+	for(const auto & entry : types)
+		result.push_back(entry.second);
+
+	std::sort(result.begin(), result.end(), [](const TypeStatistics & left, const TypeStatistics & right)
+	{
+		return left.bytes > right.bytes;
+	});
+	return result;
+}
+
+void SerializationStatistics::printTable(std::ostream & out) const
+{
+	uint64_t totalBytes = 0;
+	for(const auto & entry : types)
+		totalBytes += entry.second.bytes;
+
+	out << boost::format("%-50s %10s %14s %7s %12s\n") % "Type" % "Count" % "Bytes" % "Share" % "Time, ms";
+
+	for(const auto & entry : getSortedStatistics())
+	{
+		double share = totalBytes ? 100.0 * entry.bytes / totalBytes : 0.0;
+		double milliseconds = std::chrono::duration<double, std::milli>(entry.time).count();
+
+		out << boost::format("%-50s %10d %14d %6.2f%% %12.2f\n") % entry.name % entry.count % entry.bytes % share % milliseconds;
+	}
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,61 @@
+/*
+ * SerializationStatistics.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include <chrono>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Collects amount of data and time spent on serialization of every registered polymorphic type
+/// Can be attached to BinarySerializer or BinaryDeserializer to profile save games or network packs
+/// Data of objects that are serialized as part of another registered type is accounted only to the innermost type
+class DLL_LINKAGE SerializationStatistics
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct TypeStatistics
+	{
+		std::string name;
+		uint64_t count = 0;
+		uint64_t bytes = 0;
+		Clock::duration time = Clock::duration::zero();
+	};
+
+private:
+	struct ActiveType
+	{
+		uint16_t typeID;
+		uint64_t startPosition;
+		Clock::time_point startTime;
+		uint64_t nestedBytes;
+		Clock::duration nestedTime;
+	};
+
+	std::map<uint16_t, TypeStatistics> types;
+	std::vector<ActiveType> activeTypes;
+
+public:
+	/// Called when (de)serialization of object of specified type starts at specified position of the stream
+	void beginType(uint16_t typeID, const std::type_info & typeInfo, uint64_t position);
+
+	/// Called when (de)serialization of most recently started object ends at specified position of the stream, also if it has thrown
+	void endType(uint64_t position);
+
+	void clear();
+
+	/// Returns statistics of all encountered types, sorted by total size, in descending order
+	std::vector<TypeStatistics> getSortedStatistics() const;
+
+	/// Prints statistics as human-readable table
+	void printTable(std::ostream & out) const;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -417,12 +417,12 @@ int64_t CSpell::adjustRawDamage(const spells::Caster * caster, const battle::Uni
 		});
 
 		CSelector selector = Selector::typeSubtype(BonusType::SPELL_DAMAGE_REDUCTION, BonusSubtypeID(SpellSchool::ANY));
-		auto cachingStr = "type_SPELL_DAMAGE_REDUCTION_s_ANY";
+		auto cachingKey = BonusCacheKey::typeSubtype(BonusType::SPELL_DAMAGE_REDUCTION, BonusSubtypeID(SpellSchool::ANY));
 
 		//general spell dmg reduction, works only on magical effects
-		if(bearer->hasBonus(selector, cachingStr) && isMagical())
+		if(bearer->hasBonus(selector, cachingKey) && isMagical())
 		{
-			ret *= 100 - bearer->valOfBonuses(selector, cachingStr);
+			ret *= 100 - bearer->valOfBonuses(selector, cachingKey);
 			ret /= 100;
 		}
 
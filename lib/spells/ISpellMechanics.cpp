@@ -265,10 +265,10 @@ void BattleCast::cast(ServerCallback * server, Target target)
 	//Magic Mirror effect
 	if(tryMagicMirror)
 	{
-		const std::string magicMirrorCacheStr = "type_MAGIC_MIRROR";
+		static const auto magicMirrorCacheKey = BonusCacheKey::type(BonusType::MAGIC_MIRROR);
 		static const auto magicMirrorSelector = Selector::type()(BonusType::MAGIC_MIRROR);
 
-		const int mirrorChance = mainTarget->valOfBonuses(magicMirrorSelector, magicMirrorCacheStr);
+		const int mirrorChance = mainTarget->valOfBonuses(magicMirrorSelector, magicMirrorCacheKey);
 
 		if(server->getRNG()->nextInt(0, 99) < mirrorChance)
 		{
@@ -108,10 +108,23 @@ bool TextOperations::isValidUnicodeString(const std::string & text)
 
 bool TextOperations::isValidUnicodeString(const char * data, size_t size)
 {
-	for (size_t i=0; i<size; i += getUnicodeCharacterSize(data[i]))
+	for (size_t i=0; i<size; )
 	{
+		// fast path for ASCII text, which is always valid - check 8 characters at once
+		uint64_t word;
+		if (size - i >= sizeof(word))
+		{
+			std::memcpy(&word, data + i, sizeof(word));
+			if ((word & 0x8080808080808080ull) == 0)
+			{
+				i += sizeof(word);
+				continue;
+			}
+		}
+
 		if (!isValidUnicodeCharacter(data + i, size - i))
 			return false;
+		i += getUnicodeCharacterSize(data[i]);
 	}
 	return true;
 }
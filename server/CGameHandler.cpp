@@ -87,6 +87,10 @@
 #include <vcmi/events/GenericEvents.h>
 #include <vcmi/events/AdventureEvents.h>
 
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+
 #define COMPLAIN_RET_IF(cond, txt) do {if (cond){complain(txt); return;}} while(0)
 #define COMPLAIN_RET_FALSE_IF(cond, txt) do {if (cond){complain(txt); return false;}} while(0)
 #define COMPLAIN_RET(txt) {complain(txt); return false;}
@@ -103,6 +107,27 @@ void callWith(std::vector<T> args, std::function<void(T)> fun, ui32 which)
 	fun(args[which]);
 }
 
+/// Coalesces all packs sent to clients during its lifetime, e.g. while processing single request,
+/// into one network message per connection
+class PackBatchGuard : boost::noncopyable
+{
+	std::vector<std::shared_ptr<CConnection>> connections;
+
+public:
+	explicit PackBatchGuard(const std::vector<std::shared_ptr<CConnection>> & activeConnections)
+		: connections(activeConnections)
+	{
+		for (const auto & connection : connections)
+			connection->beginPackBatch();
+	}
+
+	~PackBatchGuard()
+	{
+		for (const auto & connection : connections)
+			connection->endPackBatch();
+	}
+};
+
 const Services * CGameHandler::services() const
 {
 	return VLC;
@@ -460,6 +485,8 @@ void CGameHandler::handleClientDisconnection(std::shared_ptr<CConnection> c)
 
 void CGameHandler::handleReceivedPack(CPackForServer & pack)
 {
+	PackBatchGuard batch(lobby->activeConnections);
+
 	//prepare struct informing that action was applied
 	auto sendPackageResponse = [&](bool successfullyApplied)
 	{
@@ -520,6 +547,7 @@ CGameHandler::CGameHandler(CVCMIServer * lobby)
 
 CGameHandler::~CGameHandler()
 {
+	waitForPendingSave();
 	delete spellEnv;
 	delete gs;
 	gs = nullptr;
@@ -738,6 +766,7 @@ void CGameHandler::start(bool resume)
 
 void CGameHandler::tick(int millisecondsPassed)
 {
+	PackBatchGuard batch(lobby->activeConnections);
 	turnTimerHandler->update(millisecondsPassed);
 }
 
@@ -1436,6 +1465,21 @@ void CGameHandler::heroExchange(ObjectInstanceID hero1, ObjectInstanceID hero2)
 
 void CGameHandler::sendToAllClients(CPackForClient & pack)
 {
+	// Every client keeps full copy of game state, so all packs that modify it must be sent to everyone
+	// Packs that are only shown by interface of specific player are sent only to clients of that player
+	PackRecipientNetPackVisitor recipientVisitor(*this);
+	pack.visit(recipientVisitor);
+	auto recipient = recipientVisitor.getRecipient();
+
+	if (recipient && connections.count(*recipient))
+	{
+		logNetwork->trace("\tSending to clients of player %s: %s", recipient->toString(), typeid(pack).name());
+		for (auto c : lobby->activeConnections)
+			if (hasPlayerAt(*recipient, c))
+				c->sendPack(pack);
+		return;
+	}
+
 	logNetwork->trace("\tSending to all clients: %s", typeid(pack).name());
 	for (auto c : lobby->activeConnections)
 		c->sendPack(pack);
@@ -1525,6 +1569,45 @@ void CGameHandler::throwAndComplain(CPackForServer * pack, std::string txt)
 	throwNotAllowedAction(pack);
 }
 
+/// Removes keyframes of delta autosaves in directory that are no longer referenced by any save
+static void removeUnusedKeyframes(const boost::filesystem::path & directory, const boost::filesystem::path & currentKeyframe)
+{
+	std::set<std::string> usedKeyframes;
+	std::vector<boost::filesystem::path> keyframes;
+
+	for(const auto & entry : boost::filesystem::directory_iterator(directory))
+	{
+		const auto & path = entry.path();
+
+		if(path.extension() == ".vsgk")
+			keyframes.push_back(path);
+
+		if(path.extension() == ".vsgm1")
+		{
+			try
+			{
+				usedKeyframes.insert(CLoadFile::getKeyframeName(path));
+			}
+			catch(const std::exception & e)
+			{
+				// can't tell which keyframe this save depends on - keep all of them
+				logGlobal->warn("Failed to read header of %s: %s", path.string(), e.what());
+				return;
+			}
+		}
+	}
+
+	for(const auto & keyframe : keyframes)
+	{
+		if(keyframe == currentKeyframe || usedKeyframes.count(keyframe.filename().string()))
+			continue;
+
+		logGlobal->info("Removing unused autosave keyframe %s", keyframe.string());
+		boost::system::error_code ec;
+		boost::filesystem::remove(keyframe, ec);
+	}
+}
+
 void CGameHandler::save(const std::string & filename)
 {
 	logGlobal->info("Saving to %s", filename);
@@ -1533,20 +1616,97 @@ void CGameHandler::save(const std::string & filename)
 	ResourcePath savePath(stem.to_string(), EResType::SAVEGAME);
 	CResourceHandler::get("local")->createResource(savefname);
 
+	const auto saveFilePath = *CResourceHandler::get("local")->getResourceName(savePath);
+
+	// Keyframe that failed to reach disk can't be used as base for following autosaves
+	waitForPendingSave();
+	if (keyframeWriteFailed)
+	{
+		autosaveKeyframe.reset();
+		autosavesSinceKeyframe = 0;
+		keyframeWriteFailed = false;
+	}
+
+	// Autosaves are stored as difference to most recent keyframe, which is written as separate full save every few autosaves
+	int keyframeInterval = settings["general"]["autosaveKeyframeInterval"].Integer();
+	bool useKeyframe = keyframeInterval > 0 && boost::algorithm::starts_with(filename, "Saves/Autosave/");
+	bool createKeyframe = useKeyframe && (!autosaveKeyframe || autosavesSinceKeyframe >= keyframeInterval || autosaveKeyframe->fName.parent_path() != saveFilePath.parent_path());
+
+	auto keyframeName = "Keyframe_" + boost::uuids::to_string(boost::uuids::random_generator()()) + ".vsgk";
+	auto save = std::make_shared<CSaveFile>(createKeyframe ? saveFilePath.parent_path() / keyframeName : saveFilePath);
+
 	try
 	{
-		{
-			CSaveFile save(*CResourceHandler::get("local")->getResourceName(savePath));
-			saveCommonState(save);
-			logGlobal->info("Saving server state");
-			save << *this;
-		}
-		logGlobal->info("Game has been successfully saved!");
+		saveCommonState(*save);
+		logGlobal->info("Saving server state");
+		*save << *this;
 	}
 	catch(std::exception &e)
 	{
 		logGlobal->error("Failed to save game: %s", e.what());
+		return;
+	}
+
+	if (createKeyframe)
+	{
+		autosaveKeyframe = save;
+		autosavesSinceKeyframe = 0;
 	}
+
+	std::shared_ptr<const CSaveFile> keyframe;
+	if (useKeyframe)
+	{
+		keyframe = autosaveKeyframe;
+		autosavesSinceKeyframe++;
+	}
+
+	// Game state is now fully captured in memory - write it to disk in background so game can continue
+	saveThread = std::make_unique<boost::thread>([this, save, keyframe, saveFilePath]()
+	{
+		setThreadName("saveGame");
+
+		try
+		{
+			if (!keyframe)
+			{
+				save->writeToDisk();
+			}
+			else
+			{
+				if (save == keyframe)
+				{
+					try
+					{
+						save->writeToDisk();
+					}
+					catch(...)
+					{
+						keyframeWriteFailed = true;
+						throw;
+					}
+				}
+
+				save->writeDeltaToDisk(saveFilePath, *keyframe);
+
+				if (save == keyframe)
+					removeUnusedKeyframes(saveFilePath.parent_path(), keyframe->fName);
+			}
+			logGlobal->info("Game has been successfully saved!");
+		}
+		catch(std::exception &e)
+		{
+			logGlobal->error("Failed to save game: %s", e.what());
+		}
+	});
+}
+
+void CGameHandler::waitForPendingSave()
+{
+	if (!saveThread)
+		return;
+
+	saveThread->join();
+	saveThread.reset();
 }
 
 bool CGameHandler::load(const std::string & filename)
@@ -1554,6 +1714,7 @@ bool CGameHandler::load(const std::string & filename)
 	logGlobal->info("Loading from %s", filename);
 	const auto stem	= FileInfo::GetPathStem(filename);
 
+	waitForPendingSave();
 	reinitScripting();
 
 	try
@@ -1593,6 +1754,15 @@ bool CGameHandler::load(const std::string & filename)
 		lobby->announceMessage(errorMsg.toString());//FIXME: should be localized on client side
 		return false;
 	}
+	catch(const MissingKeyframeException & e)
+	{
+		logGlobal->error("Failed to load game: %s", e.what());
+		MetaString errorMsg;
+		errorMsg.appendTextID("vcmi.server.errors.missingKeyframe");
+		errorMsg.replaceRawString(e.keyframeName);
+		lobby->announceMessage(errorMsg.toString());//FIXME: should be localized on client side
+		return false;
+	}
 
 	catch(const std::exception & e)
 	{
@@ -57,6 +57,15 @@ class CGameHandler : public IGameCallback, public Environment
 {
 	CVCMIServer * lobby;
 
+	/// Thread that writes most recent save game to disk
+	std::unique_ptr<boost::thread> saveThread;
+
+	/// Most recent full autosave, following autosaves are stored as difference to it
+	std::shared_ptr<const CSaveFile> autosaveKeyframe;
+	int autosavesSinceKeyframe = 0;
+	/// Set by save thread if keyframe could not be written. Only accessed after save thread has been joined
+	bool keyframeWriteFailed = false;
+
 public:
 	std::unique_ptr<HeroPoolProcessor> heroPool;
 	std::unique_ptr<BattleProcessor> battles;
@@ -228,6 +237,8 @@ public:
 	bool bulkSmartSplitStack(SlotID slotSrc, ObjectInstanceID srcOwner);
 	void save(const std::string &fname);
 	bool load(const std::string &fname);
+	/// Blocks until save game that is being written in background, if any, is on disk
+	void waitForPendingSave();
 
 	void onPlayerTurnStarted(PlayerColor which);
 	void onPlayerTurnEnded(PlayerColor which);
@@ -52,6 +52,11 @@ void ApplyOnServerNetPackVisitor::visitLobbyClientConnected(LobbyClientConnected
 
 	srv.clientConnected(pack.c, pack.names, pack.uuid, pack.mode);
 
+	// host of a server that was started by client itself is located on the same machine, compression would only waste time
+	bool isLocalHost = srv.wasStartedByClient() && pack.c->connectionID == srv.hostClientId;
+	pack.c->setCompressionEnabled(compatibleVersion >= ESerializationVersion::NETWORK_COMPRESSION && !isLocalHost);
+	pack.c->setPackBatchingEnabled(compatibleVersion >= ESerializationVersion::PACK_BATCHING);
+
 	// Server need to pass some data to newly connected client
 	pack.clientId = pack.c->connectionID;
 	pack.mode = srv.si->mode;
@@ -32,6 +32,12 @@
 void ApplyGhNetPackVisitor::visitSaveGame(SaveGame & pack)
 {
 	gh.save(pack.fname);
+
+	// Only regular autosaves may complete in background. Other saves, such as emergency save
+	// requested by Android before application is suspended, must be on disk once acknowledged
+	if(!boost::algorithm::starts_with(pack.fname, "Saves/Autosave/"))
+		gh.waitForPendingSave();
+
 	logGlobal->info("Game has been saved as %s", pack.fname);
 	result = true;
 }
@@ -441,3 +447,57 @@ void ApplyGhNetPackVisitor::visitPlayerMessage(PlayerMessage & pack)
 	gh.playerMessages->playerMessage(pack.player, pack.text, pack.currObj);
 	result = true;
 }
+
+void PackRecipientNetPackVisitor::visitPlayerBlocked(PlayerBlocked & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitHeroVisit(HeroVisit & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitInfoWindow(InfoWindow & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitBlockingDialog(BlockingDialog & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitGarrisonDialog(GarrisonDialog & pack)
+{
+	const CGHeroInstance * hero = gh.getHero(pack.hid);
+	if(hero)
+		recipient = hero->getOwner();
+}
+
+void PackRecipientNetPackVisitor::visitExchangeDialog(ExchangeDialog & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitTeleportDialog(TeleportDialog & pack)
+{
+	const CGHeroInstance * hero = gh.getHero(pack.hero);
+	if(hero)
+		recipient = hero->getOwner();
+}
+
+void PackRecipientNetPackVisitor::visitMapObjectSelectDialog(MapObjectSelectDialog & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitShowWorldViewEx(ShowWorldViewEx & pack)
+{
+	recipient = pack.player;
+}
+
+void PackRecipientNetPackVisitor::visitCenterView(CenterView & pack)
+{
+	recipient = pack.player;
+}
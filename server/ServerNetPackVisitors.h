@@ -64,3 +64,35 @@ public:
 	void visitPlayerMessage(PlayerMessage & pack) override;
 	void visitSaveLocalState(SaveLocalState & pack) override;
 };
+
+/// Finds player whose interface is the only receiver of pack on client side
+/// Such packs don't modify game state, so they don't need to be sent to clients that don't host this player
+class PackRecipientNetPackVisitor : public VCMI_LIB_WRAP_NAMESPACE(ICPackVisitor)
+{
+private:
+	std::optional<PlayerColor> recipient;
+	const CGameHandler & gh;
+
+public:
+	PackRecipientNetPackVisitor(const CGameHandler & gh)
+		:gh(gh)
+	{
+	}
+
+	/// Returns recipient of visited pack, or empty optional if pack must be sent to all clients
+	std::optional<PlayerColor> getRecipient() const
+	{
+		return recipient;
+	}
+
+	void visitPlayerBlocked(PlayerBlocked & pack) override;
+	void visitHeroVisit(HeroVisit & pack) override;
+	void visitInfoWindow(InfoWindow & pack) override;
+	void visitBlockingDialog(BlockingDialog & pack) override;
+	void visitGarrisonDialog(GarrisonDialog & pack) override;
+	void visitExchangeDialog(ExchangeDialog & pack) override;
+	void visitTeleportDialog(TeleportDialog & pack) override;
+	void visitMapObjectSelectDialog(MapObjectSelectDialog & pack) override;
+	void visitShowWorldViewEx(ShowWorldViewEx & pack) override;
+	void visitCenterView(CenterView & pack) override;
+};
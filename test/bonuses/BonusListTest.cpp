@@ -0,0 +1,165 @@
+/*
+ * BonusListTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/bonuses/BonusList.h"
+#include "../../lib/bonuses/BonusSelector.h"
+
+namespace test
+{
+
+class BonusListTest : public ::testing::Test
+{
+public:
+	const std::vector<BonusType> types = {BonusType::PRIMARY_SKILL, BonusType::STACKS_SPEED, BonusType::FLYING, BonusType::MORALE, BonusType::LUCK};
+
+	BonusList indexed;
+	std::vector<CSelector> selectors;
+	std::mt19937 rng{1};
+
+	void SetUp() override
+	{
+		for(int i = 0; i < 300; ++i)
+			indexed.push_back(makeBonus());
+		indexed.enableTypeIndex();
+
+		for(const auto & type : types)
+		{
+			selectors.push_back(Selector::type()(type));
+			selectors.push_back(Selector::typeSubtype(type, BonusSubtypeID(PrimarySkill::ATTACK)));
+			selectors.push_back(Selector::type()(type).And(Selector::sourceTypeSel(BonusSource::ARTIFACT)));
+			selectors.push_back(Selector::type()(type).Or(Selector::type()(BonusType::LUCK)));
+		}
+
+		// type not present in list at all
+		selectors.push_back(Selector::type()(BonusType::NO_MORALE));
+
+		// selectors without required type must visit whole list
+		selectors.push_back(Selector::all);
+		selectors.push_back(Selector::sourceTypeSel(BonusSource::SPELL_EFFECT));
+		selectors.push_back(Selector::type()(BonusType::MORALE).Not());
+		selectors.push_back([](const Bonus * b){ return b->val > 5; });
+	}
+
+	std::shared_ptr<Bonus> makeBonus()
+	{
+		const std::vector<BonusSource> sources = {BonusSource::SPELL_EFFECT, BonusSource::ARTIFACT, BonusSource::CREATURE_ABILITY};
+		const std::vector<BonusSubtypeID> subtypes = {BonusSubtypeID(), BonusSubtypeID(PrimarySkill::ATTACK), BonusSubtypeID(PrimarySkill::DEFENSE)};
+
+		auto type = types[rng() % types.size()];
+		auto source = sources[rng() % sources.size()];
+		auto subtype = subtypes[rng() % subtypes.size()];
+		return std::make_shared<Bonus>(BonusDuration::PERMANENT, type, source, static_cast<int>(rng() % 10), BonusSourceID(), subtype);
+	}
+
+	static std::vector<std::shared_ptr<Bonus>> linearFilter(const BonusList & list, const CSelector & selector, const CSelector & limit = nullptr)
+	{
+		std::vector<std::shared_ptr<Bonus>> result;
+		for(const auto & bonus : list)
+		{
+			if(selector(bonus.get()) && (!limit || limit(bonus.get())))
+				result.push_back(bonus);
+		}
+		return result;
+	}
+
+	static std::vector<std::shared_ptr<Bonus>> toVector(const BonusList & list)
+	{
+		return std::vector<std::shared_ptr<Bonus>>(list.begin(), list.end());
+	}
+
+	void checkQueries() const
+	{
+		ASSERT_TRUE(indexed.hasTypeIndex());
+
+		for(const auto & selector : selectors)
+		{
+			const auto expected = linearFilter(indexed, selector);
+
+			BonusList result;
+			indexed.getBonuses(result, selector);
+			EXPECT_EQ(toVector(result), expected);
+
+			EXPECT_EQ(indexed.getFirst(selector), expected.empty() ? nullptr : expected.front());
+
+			// copy of list does not have index, so it is always searched linearly
+			BonusList unindexed(indexed);
+			EXPECT_EQ(indexed.valOfBonuses(selector), unindexed.valOfBonuses(selector));
+
+			// required type of limit may be used to narrow down search as well
+			for(const auto & limit : selectors)
+			{
+				BonusList limited;
+				indexed.getBonuses(limited, Selector::all, limit);
+				EXPECT_EQ(toVector(limited), linearFilter(indexed, Selector::all, limit));
+			}
+		}
+	}
+};
+
+TEST_F(BonusListTest, queries)
+{
+	checkQueries();
+}
+
+TEST_F(BonusListTest, pushBack)
+{
+	for(int i = 0; i < 100; ++i)
+		indexed.push_back(makeBonus());
+	checkQueries();
+}
+
+TEST_F(BonusListTest, erase)
+{
+	indexed.erase(0);
+	indexed.erase(100);
+	indexed.erase(static_cast<int>(indexed.size() - 1));
+	checkQueries();
+
+	auto removed = indexed[50];
+	indexed -= removed;
+	checkQueries();
+}
+
+TEST_F(BonusListTest, removeIf)
+{
+	indexed.remove_if([](const Bonus * b){ return b->type == BonusType::FLYING || b->val == 3; });
+	checkQueries();
+}
+
+TEST_F(BonusListTest, insert)
+{
+	auto inserted = makeBonus();
+	auto position = indexed.begin() + 10;
+	indexed.insert(position, 5, inserted);
+	checkQueries();
+}
+
+TEST_F(BonusListTest, assignment)
+{
+	BonusList other;
+	for(int i = 0; i < 50; ++i)
+		other.push_back(makeBonus());
+
+	indexed = other;
+	checkQueries();
+
+	indexed.clear();
+	checkQueries();
+}
+
+TEST_F(BonusListTest, stackBonuses)
+{
+	indexed.stackBonuses();
+	checkQueries();
+}
+
+}
@@ -0,0 +1,184 @@
+/*
+ * BonusSelectorTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/bonuses/BonusSelector.h"
+
+namespace test
+{
+
+/// Selector compiled into expression tree, together with equivalent selector that is evaluated as plain function
+struct SelectorPair
+{
+	CSelector compiled;
+	CSelector interpreted;
+	std::string name;
+};
+
+class BonusSelectorTest : public ::testing::Test
+{
+public:
+	std::vector<std::shared_ptr<Bonus>> bonuses;
+	std::vector<SelectorPair> leaves;
+	std::mt19937 rng{1};
+
+	void SetUp() override
+	{
+		const std::vector<BonusType> types = {BonusType::PRIMARY_SKILL, BonusType::STACKS_SPEED, BonusType::FLYING, BonusType::MORALE};
+		const std::vector<BonusSubtypeID> subtypes = {BonusSubtypeID(), BonusSubtypeID(PrimarySkill::ATTACK), BonusSubtypeID(PrimarySkill::DEFENSE)};
+		const std::vector<BonusSource> sources = {BonusSource::SPELL_EFFECT, BonusSource::ARTIFACT, BonusSource::CREATURE_ABILITY};
+		const std::vector<BonusSourceID> sourceIDs = {BonusSourceID(), BonusSourceID(SpellID(SpellID::BLESS)), BonusSourceID(CreatureID(1))};
+		const std::vector<BonusValueType> valueTypes = {BonusValueType::ADDITIVE_VALUE, BonusValueType::BASE_NUMBER, BonusValueType::PERCENT_TO_ALL};
+		const std::vector<BonusDuration::Type> durations = {BonusDuration::PERMANENT, BonusDuration::N_TURNS, BonusDuration::N_DAYS, BonusDuration::ONE_DAY, BonusDuration::ONE_BATTLE};
+
+		auto pick = [this](const auto & values)
+		{
+			return values[rng() % values.size()];
+		};
+
+		for(int i = 0; i < 500; ++i)
+		{
+			auto bonus = std::make_shared<Bonus>(pick(durations), pick(types), pick(sources), static_cast<int>(rng() % 10), pick(sourceIDs), pick(subtypes), pick(valueTypes));
+			bonus->turnsRemain = rng() % 5;
+			bonus->additionalInfo = CAddInfo(static_cast<int>(rng() % 3));
+			bonus->effectRange = rng() % 2 ? BonusLimitEffect::NO_LIMIT : BonusLimitEffect::ONLY_MELEE_FIGHT;
+			bonuses.push_back(bonus);
+		}
+
+		for(const auto & type : types)
+			addLeaf(Selector::type()(type), [type](const Bonus * b){ return b->type == type; }, "type");
+
+		for(const auto & subtype : subtypes)
+			addLeaf(Selector::subtype()(subtype), [subtype](const Bonus * b){ return b->subtype == subtype; }, "subtype");
+
+		for(const auto & source : sources)
+		{
+			addLeaf(Selector::sourceTypeSel(source), [source](const Bonus * b){ return b->source == source; }, "source");
+			for(const auto & sourceID : sourceIDs)
+				addLeaf(Selector::source(source, sourceID), [source, sourceID](const Bonus * b){ return b->source == source && b->sid == sourceID; }, "sourceID");
+		}
+
+		for(const auto & valueType : valueTypes)
+			addLeaf(Selector::valueType(valueType), [valueType](const Bonus * b){ return b->valType == valueType; }, "valueType");
+
+		addLeaf(Selector::typeSubtype(BonusType::PRIMARY_SKILL, BonusSubtypeID(PrimarySkill::ATTACK)), [](const Bonus * b)
+		{
+			return b->type == BonusType::PRIMARY_SKILL && b->subtype == BonusSubtypeID(PrimarySkill::ATTACK);
+		}, "typeSubtype");
+
+		addLeaf(Selector::typeSubtypeInfo(BonusType::MORALE, BonusSubtypeID(), CAddInfo(1)), [](const Bonus * b)
+		{
+			return b->type == BonusType::MORALE && b->subtype == BonusSubtypeID() && b->additionalInfo == CAddInfo(1);
+		}, "typeSubtypeInfo");
+
+		addLeaf(Selector::effectRange()(BonusLimitEffect::ONLY_MELEE_FIGHT), [](const Bonus * b){ return b->effectRange == BonusLimitEffect::ONLY_MELEE_FIGHT; }, "effectRange");
+
+		for(int turns = 0; turns < 4; ++turns)
+		{
+			addLeaf(Selector::turns(turns), CWillLastTurns(turns), "turns");
+			addLeaf(Selector::days(turns), CWillLastDays(turns), "days");
+		}
+
+		addLeaf(Selector::all, [](const Bonus * b){ return true; }, "all");
+		addLeaf(Selector::none, [](const Bonus * b){ return false; }, "none");
+	}
+
+	void addLeaf(const CSelector & compiled, const std::function<bool(const Bonus *)> & interpreted, const std::string & name)
+	{
+		leaves.push_back({compiled, CSelector(interpreted), name});
+	}
+
+	/// Builds random combination of leaf selectors using And, Or and Not
+	SelectorPair makeExpression(int depth)
+	{
+		if(depth == 0 || rng() % 4 == 0)
+			return leaves[rng() % leaves.size()];
+
+		switch(rng() % 3)
+		{
+			case 0:
+			{
+				auto lhs = makeExpression(depth - 1);
+				auto rhs = makeExpression(depth - 1);
+				return {lhs.compiled.And(rhs.compiled), CSelector([lhs, rhs](const Bonus * b){ return lhs.interpreted(b) && rhs.interpreted(b); }), "(" + lhs.name + " and " + rhs.name + ")"};
+			}
+			case 1:
+			{
+				auto lhs = makeExpression(depth - 1);
+				auto rhs = makeExpression(depth - 1);
+				return {lhs.compiled.Or(rhs.compiled), CSelector([lhs, rhs](const Bonus * b){ return lhs.interpreted(b) || rhs.interpreted(b); }), "(" + lhs.name + " or " + rhs.name + ")"};
+			}
+			default:
+			{
+				auto operand = makeExpression(depth - 1);
+				return {operand.compiled.Not(), CSelector([operand](const Bonus * b){ return !operand.interpreted(b); }), "not " + operand.name};
+			}
+		}
+	}
+
+	void checkSelector(const SelectorPair & selector) const
+	{
+		SCOPED_TRACE(selector.name);
+
+		const auto requiredType = selector.compiled.getRequiredType();
+		for(const auto & bonus : bonuses)
+		{
+			const bool selected = selector.compiled(bonus.get());
+			EXPECT_EQ(selected, selector.interpreted(bonus.get()));
+
+			// required type is used to skip bonuses, so it must never reject bonus that selector accepts
+			if(selected && requiredType)
+			{
+				EXPECT_EQ(bonus->type, *requiredType);
+			}
+		}
+	}
+};
+
+TEST_F(BonusSelectorTest, leaves)
+{
+	for(const auto & leaf : leaves)
+		checkSelector(leaf);
+}
+
+TEST_F(BonusSelectorTest, chains)
+{
+	// chains of the same operation are flattened into single instruction
+	for(size_t i = 0; i + 2 < leaves.size(); ++i)
+	{
+		const auto & a = leaves[i];
+		const auto & b = leaves[i + 1];
+		const auto & c = leaves[i + 2];
+
+		checkSelector({a.compiled.And(b.compiled).And(c.compiled), CSelector([&](const Bonus * x){ return a.interpreted(x) && b.interpreted(x) && c.interpreted(x); }), "and chain"});
+		checkSelector({a.compiled.Or(b.compiled).Or(c.compiled), CSelector([&](const Bonus * x){ return a.interpreted(x) || b.interpreted(x) || c.interpreted(x); }), "or chain"});
+		checkSelector({a.compiled.Not().Not(), a.interpreted, "double negation"});
+		checkSelector({a.compiled.And(b.compiled.Or(c.compiled)).Not(), CSelector([&](const Bonus * x){ return !(a.interpreted(x) && (b.interpreted(x) || c.interpreted(x))); }), "mixed"});
+	}
+}
+
+TEST_F(BonusSelectorTest, randomExpressions)
+{
+	for(int i = 0; i < 300; ++i)
+		checkSelector(makeExpression(4));
+}
+
+TEST_F(BonusSelectorTest, mixedWithFunctions)
+{
+	// lambdas may be combined with compiled selectors and are evaluated in place
+	const auto & primarySkill = leaves.front();
+	CSelector odd([](const Bonus * b){ return b->val % 2 != 0; });
+
+	checkSelector({primarySkill.compiled.And(odd), CSelector([&](const Bonus * x){ return primarySkill.interpreted(x) && x->val % 2 != 0; }), "and function"});
+	checkSelector({odd.Or(primarySkill.compiled).Not(), CSelector([&](const Bonus * x){ return !(x->val % 2 != 0 || primarySkill.interpreted(x)); }), "or function"});
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * CBonusSystemNodeTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/bonuses/CBonusSystemNode.h"
+#include "../../lib/bonuses/BonusSelector.h"
+
+namespace test
+{
+
+class CBonusSystemNodeTest : public ::testing::Test
+{
+public:
+	static std::shared_ptr<Bonus> makeBonus(int value)
+	{
+		return std::make_shared<Bonus>(BonusDuration::PERMANENT, BonusType::MORALE, BonusSource::OTHER, value, BonusSourceID());
+	}
+
+	/// Value of morale through cached query, same as most of the game uses
+	static int morale(const CBonusSystemNode & node)
+	{
+		return node.valOfBonuses(BonusType::MORALE);
+	}
+};
+
+TEST_F(CBonusSystemNodeTest, parentChangeInvalidatesDescendants)
+{
+	CBonusSystemNode grandparent(CBonusSystemNode::PLAYER);
+	CBonusSystemNode parent(CBonusSystemNode::HERO);
+	CBonusSystemNode child(CBonusSystemNode::STACK_INSTANCE);
+	parent.attachTo(grandparent);
+	child.attachTo(parent);
+
+	EXPECT_EQ(morale(parent), 0);
+	EXPECT_EQ(morale(child), 0);
+
+	auto bonus = makeBonus(2);
+	grandparent.addNewBonus(bonus);
+	EXPECT_EQ(morale(parent), 2);
+	EXPECT_EQ(morale(child), 2);
+
+	// in-place change of bonus must be announced by its node
+	grandparent.accumulateBonus(makeBonus(1));
+	EXPECT_EQ(morale(parent), 3);
+	EXPECT_EQ(morale(child), 3);
+
+	parent.addNewBonus(makeBonus(5));
+	EXPECT_EQ(morale(grandparent), 3);
+	EXPECT_EQ(morale(child), 8);
+
+	grandparent.removeBonus(bonus);
+	EXPECT_EQ(morale(parent), 5);
+	EXPECT_EQ(morale(child), 5);
+}
+
+TEST_F(CBonusSystemNodeTest, siblingChangeKeepsCache)
+{
+	CBonusSystemNode parent(CBonusSystemNode::HERO);
+	CBonusSystemNode first(CBonusSystemNode::STACK_INSTANCE);
+	CBonusSystemNode second(CBonusSystemNode::STACK_INSTANCE);
+	first.attachTo(parent);
+	second.attachTo(parent);
+
+	EXPECT_EQ(morale(first), 0);
+	const int64_t version = first.getTreeVersion();
+
+	second.addNewBonus(makeBonus(1));
+	EXPECT_EQ(first.getTreeVersion(), version);
+	EXPECT_EQ(morale(first), 0);
+	EXPECT_EQ(morale(second), 1);
+}
+
+TEST_F(CBonusSystemNodeTest, attachToSource)
+{
+	CBonusSystemNode source(CBonusSystemNode::ARTIFACT);
+	CBonusSystemNode node(CBonusSystemNode::HERO);
+	CBonusSystemNode child(CBonusSystemNode::STACK_INSTANCE);
+	child.attachTo(node);
+	node.attachToSource(source);
+
+	EXPECT_EQ(morale(child), 0);
+
+	source.addNewBonus(makeBonus(3));
+	EXPECT_EQ(morale(node), 3);
+	EXPECT_EQ(morale(child), 3);
+
+	node.detachFromSource(source);
+	EXPECT_EQ(morale(node), 0);
+	EXPECT_EQ(morale(child), 0);
+
+	// source no longer knows about detached node
+	source.addNewBonus(makeBonus(1));
+	EXPECT_EQ(morale(child), 0);
+}
+
+TEST_F(CBonusSystemNodeTest, hypotheticChild)
+{
+	CBonusSystemNode parent(CBonusSystemNode::HERO);
+	CBonusSystemNode hypothetic(true);
+	hypothetic.attachTo(parent);
+
+	EXPECT_EQ(morale(hypothetic), 0);
+
+	parent.addNewBonus(makeBonus(4));
+	EXPECT_EQ(morale(hypothetic), 4);
+
+	hypothetic.detachFrom(parent);
+	EXPECT_EQ(morale(hypothetic), 0);
+}
+
+TEST_F(CBonusSystemNodeTest, parentDestroyedBeforeInheritingChildren)
+{
+	auto parent = std::make_unique<CBonusSystemNode>(CBonusSystemNode::HERO);
+	CBonusSystemNode sourceChild(CBonusSystemNode::STACK_INSTANCE);
+	CBonusSystemNode hypothetic(true);
+	CBonusSystemNode grandchild(CBonusSystemNode::STACK_INSTANCE);
+	sourceChild.attachToSource(*parent);
+	hypothetic.attachTo(*parent);
+	grandchild.attachTo(sourceChild);
+
+	parent->addNewBonus(makeBonus(2));
+	EXPECT_EQ(morale(sourceChild), 2);
+	EXPECT_EQ(morale(hypothetic), 2);
+	EXPECT_EQ(morale(grandchild), 2);
+
+	parent.reset();
+
+	EXPECT_TRUE(sourceChild.getParentNodes().empty());
+	EXPECT_TRUE(hypothetic.getParentNodes().empty());
+	EXPECT_EQ(morale(sourceChild), 0);
+	EXPECT_EQ(morale(hypothetic), 0);
+	EXPECT_EQ(morale(grandchild), 0);
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * JsonUtilsTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/json/JsonUtils.h"
+
+namespace test
+{
+
+TEST(JsonUtilsTest, assembleFromValidFiles)
+{
+	bool isValid = false;
+	JsonNode result = JsonUtils::assembleFromFiles(std::vector<std::string>{"test/JsonUtils/valid"}, isValid);
+
+	EXPECT_TRUE(isValid);
+	EXPECT_EQ(result["first"]["value"].Integer(), 1);
+}
+
+// Mod data is cached only if it was assembled without errors, so single broken file must invalidate whole result
+TEST(JsonUtilsTest, assembleFromFilesWithParseError)
+{
+	bool isValid = true;
+	JsonUtils::assembleFromFiles(std::vector<std::string>{"test/JsonUtils/valid", "test/JsonUtils/invalid"}, isValid);
+	EXPECT_FALSE(isValid);
+
+	isValid = true;
+	JsonUtils::assembleFromFiles(std::vector<std::string>{"test/JsonUtils/invalid", "test/JsonUtils/valid"}, isValid);
+	EXPECT_FALSE(isValid);
+}
+
+TEST(JsonUtilsTest, assembleFromMissingFile)
+{
+	bool isValid = true;
+	JsonUtils::assembleFromFiles(std::vector<std::string>{"test/JsonUtils/valid", "test/JsonUtils/missing"}, isValid);
+	EXPECT_FALSE(isValid);
+}
+
+}
@@ -0,0 +1,77 @@
+/*
+ * JsonValidatorTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/json/JsonNode.h"
+#include "../../lib/json/JsonValidator.h"
+
+namespace test
+{
+
+// Error messages are shown to mod authors, so compiled schemas must report them exactly as before
+class JsonValidatorTest : public ::testing::Test
+{
+public:
+	static constexpr const char * schemaName = "vcmi:road";
+
+	JsonNode makeRoad() const
+	{
+		JsonNode road;
+		road["shortIdentifier"].String() = "pc";
+		road["text"].String() = "Paved road";
+		road["moveCost"].Integer() = 50;
+		return road;
+	}
+
+	std::string check(const JsonNode & data) const
+	{
+		JsonValidator validator;
+		return validator.check(schemaName, data);
+	}
+};
+
+TEST_F(JsonValidatorTest, requiredEntryMissing)
+{
+	// file name of road graphics is left out to avoid check for presence of animation file
+	JsonNode road = makeRoad();
+	road["index"].Integer() = 1;
+
+	EXPECT_EQ(check(road), "At <root>\n\t Error: Required entry tilesFilename is missing\n");
+}
+
+TEST_F(JsonValidatorTest, typeMismatchOfRoot)
+{
+	EXPECT_EQ(check(JsonNode("road")), "At <root>\n\t Error: Type mismatch! Expected object\n");
+}
+
+TEST_F(JsonValidatorTest, typeMismatchOfProperty)
+{
+	JsonNode road = makeRoad();
+	road["moveCost"].String() = "fast";
+
+	EXPECT_EQ(check(road),
+		"At /moveCost\n\t Error: Type mismatch! Expected number\n"
+		"At <root>\n\t Error: Required entry tilesFilename is missing\n");
+}
+
+TEST_F(JsonValidatorTest, unknownEntryWithSuggestion)
+{
+	JsonNode road = makeRoad();
+	road.Struct().erase("moveCost");
+	road["moveCosts"].Integer() = 50;
+
+	EXPECT_EQ(check(road),
+		"At <root>\n\t Error: Unknown entry found: 'moveCosts'. Perhaps you meant 'moveCost'?\n"
+		"At <root>\n\t Error: Required entry tilesFilename is missing\n"
+		"At <root>\n\t Error: Required entry moveCost is missing\n");
+}
+
+}
@@ -0,0 +1,141 @@
+/*
+ * CPathNodeQueueTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/pathfinder/CGPathNode.h"
+
+namespace test
+{
+
+class CPathNodeQueueTest : public ::testing::Test
+{
+public:
+	std::vector<CGPathNode> nodes;
+	CPathNodeQueue queue;
+	std::mt19937 rng{1};
+
+	float randomCost(float minimalCost)
+	{
+		return minimalCost + std::uniform_real_distribution<float>(0.f, 10.f)(rng);
+	}
+
+	/// Lowest cost among all queued nodes, found without relying on heap order
+	float minimalQueuedCost() const
+	{
+		float result = std::numeric_limits<float>::max();
+		for(const auto & node : nodes)
+		{
+			if(node.inPQ())
+				result = std::min(result, node.getCost());
+		}
+		return result;
+	}
+
+	void checkTop() const
+	{
+		ASSERT_FALSE(queue.empty());
+		EXPECT_EQ(queue.top()->getCost(), minimalQueuedCost());
+		EXPECT_EQ(queue.top()->pqIndex, 0u);
+	}
+};
+
+TEST_F(CPathNodeQueueTest, popsInOrderOfCost)
+{
+	nodes.resize(1000);
+	for(auto & node : nodes)
+	{
+		node.setCost(randomCost(0));
+		queue.push(&node);
+	}
+	EXPECT_EQ(queue.size(), nodes.size());
+
+	float lastCost = 0;
+	while(!queue.empty())
+	{
+		checkTop();
+		CGPathNode * node = queue.top();
+		queue.pop();
+
+		EXPECT_FALSE(node->inPQ());
+		EXPECT_GE(node->getCost(), lastCost);
+		lastCost = node->getCost();
+	}
+}
+
+TEST_F(CPathNodeQueueTest, decreaseKey)
+{
+	nodes.resize(1000);
+	for(auto & node : nodes)
+	{
+		node.setCost(randomCost(0));
+		queue.push(&node);
+	}
+
+	// same pattern as in pathfinder - costs of queued nodes are lowered, but never below cost of last popped node
+	float lastCost = 0;
+	while(!queue.empty())
+	{
+		for(int i = 0; i < 5; ++i)
+		{
+			auto & node = nodes[rng() % nodes.size()];
+			if(node.inPQ())
+				node.setCost(std::max(lastCost, node.getCost() - randomCost(0) / 2));
+		}
+
+		checkTop();
+		CGPathNode * node = queue.top();
+		queue.pop();
+
+		EXPECT_GE(node->getCost(), lastCost);
+		lastCost = node->getCost();
+	}
+}
+
+TEST_F(CPathNodeQueueTest, increaseKeyAndReinsert)
+{
+	nodes.resize(300);
+	for(auto & node : nodes)
+	{
+		node.setCost(randomCost(0));
+		queue.push(&node);
+	}
+
+	for(int step = 0; step < 3000; ++step)
+	{
+		auto & node = nodes[rng() % nodes.size()];
+
+		if(!node.inPQ())
+		{
+			node.setCost(randomCost(0));
+			queue.push(&node);
+		}
+		else if(rng() % 2)
+			node.setCost(node.getCost() / 2);
+		else
+			node.setCost(node.getCost() + randomCost(0));
+
+		checkTop();
+
+		if(rng() % 3 == 0)
+			queue.pop();
+	}
+
+	// every node that is marked as queued must actually be in queue
+	size_t queued = 0;
+	for(const auto & node : nodes)
+	{
+		if(node.inPQ())
+			queued++;
+	}
+	EXPECT_EQ(queue.size(), queued);
+}
+
+}
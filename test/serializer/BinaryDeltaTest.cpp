@@ -0,0 +1,74 @@
+/*
+ * BinaryDeltaTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/serializer/BinaryDelta.h"
+
+namespace test
+{
+
+static std::vector<std::byte> makeData(size_t size, uint32_t seed)
+{
+	std::vector<std::byte> result(size);
+	std::mt19937 rng(seed);
+	for(auto & byte : result)
+		byte = static_cast<std::byte>(rng());
+	return result;
+}
+
+TEST(BinaryDeltaTest, identicalData)
+{
+	auto base = makeData(100000, 1);
+	auto delta = BinaryDelta::encode(base, base);
+
+	EXPECT_LT(delta.size(), 16);
+	EXPECT_EQ(BinaryDelta::decode(base, delta), base);
+}
+
+TEST(BinaryDeltaTest, modifiedData)
+{
+	auto base = makeData(100000, 1);
+	auto target = base;
+
+	auto inserted = makeData(500, 2);
+	target[100] = std::byte{42};
+	target.insert(target.begin() + 5000, inserted.begin(), inserted.end());
+	target.erase(target.begin() + 50000, target.begin() + 50300);
+
+	auto delta = BinaryDelta::encode(base, target);
+
+	EXPECT_LT(delta.size(), 1000);
+	EXPECT_EQ(BinaryDelta::decode(base, delta), target);
+}
+
+TEST(BinaryDeltaTest, unrelatedData)
+{
+	auto base = makeData(1000, 1);
+	auto target = makeData(2000, 2);
+
+	EXPECT_EQ(BinaryDelta::decode(base, BinaryDelta::encode(base, target)), target);
+	EXPECT_EQ(BinaryDelta::decode({}, BinaryDelta::encode({}, target)), target);
+	EXPECT_EQ(BinaryDelta::decode(base, BinaryDelta::encode(base, {})), std::vector<std::byte>());
+}
+
+TEST(BinaryDeltaTest, malformedDelta)
+{
+	auto base = makeData(1000, 1);
+	auto delta = BinaryDelta::encode(base, base);
+
+	delta.pop_back();
+	EXPECT_THROW(BinaryDelta::decode(base, delta), std::runtime_error);
+
+	base.resize(500);
+	EXPECT_THROW(BinaryDelta::decode(base, BinaryDelta::encode(makeData(1000, 1), makeData(1000, 1))), std::runtime_error);
+}
+
+}
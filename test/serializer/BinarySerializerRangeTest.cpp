@@ -0,0 +1,177 @@
+/*
+ * BinarySerializerRangeTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/serializer/BinaryDeserializer.h"
+#include "../../lib/serializer/BinarySerializer.h"
+
+namespace test
+{
+
+enum class ETestEnum : int8_t
+{
+	NEGATIVE = -100,
+	ZERO = 0,
+	POSITIVE = 100
+};
+
+enum ETestPlainEnum
+{
+	FIRST = 0,
+	LARGE = 1000000
+};
+
+class BinaryMemoryStream : public IBinaryReader, public IBinaryWriter
+{
+public:
+	std::vector<std::byte> buffer;
+	size_t readPosition = 0;
+
+	int read(std::byte * data, unsigned size) override
+	{
+		if(readPosition + size > buffer.size())
+			throw std::runtime_error("Unexpected end of buffer");
+
+		std::copy_n(buffer.data() + readPosition, size, data);
+		readPosition += size;
+		return size;
+	}
+
+	int write(const std::byte * data, unsigned size) override
+	{
+		buffer.insert(buffer.end(), data, data + size);
+		return size;
+	}
+};
+
+template<typename T>
+static std::vector<T> makeValues(size_t count, uint32_t seed)
+{
+	// values are kept within 32-bit range, which is what compact integer encoding supports
+	const int64_t lowest = std::max<int64_t>(std::numeric_limits<T>::min(), std::numeric_limits<int32_t>::min() + 1);
+	const int64_t highest = std::min<int64_t>(std::numeric_limits<T>::max(), std::numeric_limits<int32_t>::max());
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int64_t> distribution(lowest, highest);
+
+	std::vector<T> result;
+	for(size_t i = 0; i < count; ++i)
+		result.push_back(static_cast<T>(distribution(rng)));
+	return result;
+}
+
+/// Serializes vector element by element, as it was done before containers were serialized as single block
+template<typename T>
+static std::vector<std::byte> saveElementwise(const std::vector<T> & values, ESerializationVersion version)
+{
+	BinaryMemoryStream stream;
+	BinarySerializer serializer(&stream);
+	serializer.version = version;
+
+	uint32_t length = values.size();
+	serializer & length;
+	for(const auto & value : values)
+		serializer & value;
+	return stream.buffer;
+}
+
+/// Serializes vector as it would be done by system with different endianness
+template<typename T>
+static std::vector<std::byte> saveReversed(const std::vector<T> & values, ESerializationVersion version)
+{
+	// compact form of integers is written byte by byte and does not depend on endianness
+	if(version >= ESerializationVersion::COMPACT_INTEGER_SERIALIZATION)
+		return saveElementwise(values, version);
+
+	std::vector<std::byte> result;
+	auto appendReversed = [&result](auto value)
+	{
+		const auto * bytes = reinterpret_cast<const std::byte *>(&value);
+		result.insert(result.end(), std::make_reverse_iterator(bytes + sizeof(value)), std::make_reverse_iterator(bytes));
+	};
+
+	appendReversed(static_cast<uint32_t>(values.size()));
+	for(const auto & value : values)
+	{
+		// enums are always serialized as 32-bit integers
+		if constexpr(std::is_enum_v<T>)
+			appendReversed(static_cast<int32_t>(value));
+		else
+			appendReversed(value);
+	}
+	return result;
+}
+
+template<typename T>
+static void checkRoundTrip(const std::vector<T> & values, ESerializationVersion version, bool reverseEndianness)
+{
+	BinaryMemoryStream stream;
+	BinarySerializer serializer(&stream);
+	serializer.version = version;
+	serializer & values;
+
+	// serializing whole vector at once must produce exactly the same data as serializing every element separately
+	EXPECT_EQ(stream.buffer, saveElementwise(values, version));
+
+	if(reverseEndianness)
+		stream.buffer = saveReversed(values, version);
+
+	BinaryDeserializer deserializer(&stream);
+	deserializer.version = version;
+	deserializer.reverseEndianness = reverseEndianness;
+
+	std::vector<T> loaded;
+	deserializer & loaded;
+
+	EXPECT_EQ(loaded, values);
+	EXPECT_EQ(stream.readPosition, stream.buffer.size());
+}
+
+template<typename T>
+static void checkRoundTrip(const std::vector<T> & values)
+{
+	for(auto version : {ESerializationVersion::MINIMAL, ESerializationVersion::CURRENT})
+	{
+		checkRoundTrip(values, version, false);
+		checkRoundTrip(values, version, true);
+	}
+}
+
+TEST(BinarySerializerRangeTest, singleByteIntegers)
+{
+	checkRoundTrip(makeValues<int8_t>(1000, 1));
+	checkRoundTrip(makeValues<uint8_t>(1000, 2));
+}
+
+TEST(BinarySerializerRangeTest, wideIntegers)
+{
+	checkRoundTrip(makeValues<int16_t>(1000, 3));
+	checkRoundTrip(makeValues<uint16_t>(1000, 4));
+	checkRoundTrip(makeValues<int32_t>(1000, 5));
+	checkRoundTrip(makeValues<uint32_t>(1000, 6));
+	checkRoundTrip(makeValues<int64_t>(1000, 7));
+}
+
+TEST(BinarySerializerRangeTest, boundaryValues)
+{
+	checkRoundTrip(std::vector<int8_t>{std::numeric_limits<int8_t>::min(), -1, 0, 1, std::numeric_limits<int8_t>::max()});
+	checkRoundTrip(std::vector<int16_t>{std::numeric_limits<int16_t>::min(), -64, -63, 63, 64, std::numeric_limits<int16_t>::max()});
+	checkRoundTrip(std::vector<int32_t>{std::numeric_limits<int32_t>::min() + 1, -8192, 8191, std::numeric_limits<int32_t>::max()});
+	checkRoundTrip(std::vector<int32_t>{});
+}
+
+TEST(BinarySerializerRangeTest, enums)
+{
+	checkRoundTrip(std::vector<ETestEnum>{ETestEnum::NEGATIVE, ETestEnum::ZERO, ETestEnum::POSITIVE, ETestEnum::ZERO});
+	checkRoundTrip(std::vector<ETestPlainEnum>{FIRST, LARGE, LARGE, FIRST});
+}
+
+}
@@ -0,0 +1,195 @@
+/*
+ * CSaveFileTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/serializer/CLoadFile.h"
+#include "../../lib/serializer/CSaveFile.h"
+
+namespace test
+{
+
+class CSaveFileTest : public ::testing::Test
+{
+public:
+	static constexpr const char * magicBytes = "VCMI test save";
+
+	boost::filesystem::path directory;
+
+	std::string header = "Save game header";
+	std::vector<uint8_t> bytes;
+	std::vector<int32_t> integers;
+
+	void SetUp() override
+	{
+		directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vcmi-test-%%%%-%%%%");
+		boost::filesystem::create_directories(directory);
+
+		// larger than single chunk passed to compressor
+		std::mt19937 rng(1);
+		bytes.resize(3 * 1024 * 1024 + 123);
+		for(auto & byte : bytes)
+			byte = static_cast<uint8_t>(rng() % 16);
+
+		for(int32_t i = 0; i < 100000; ++i)
+			integers.push_back(i * 37 - 1000000);
+	}
+
+	void TearDown() override
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove_all(directory, ec);
+	}
+
+	std::shared_ptr<CSaveFile> makeSave(const boost::filesystem::path & path) const
+	{
+		auto save = std::make_shared<CSaveFile>(path);
+		save->putMagicBytes(magicBytes);
+		*save << header;
+		save->markHeaderEnd();
+		*save << bytes << integers;
+		return save;
+	}
+
+	void checkHeader(CLoadFile & load) const
+	{
+		std::string loadedHeader;
+		load.checkMagicBytes(magicBytes);
+		load >> loadedHeader;
+		EXPECT_EQ(loadedHeader, header);
+	}
+
+	void checkContent(CLoadFile & load) const
+	{
+		std::vector<uint8_t> loadedBytes;
+		std::vector<int32_t> loadedIntegers;
+
+		checkHeader(load);
+		load >> loadedBytes >> loadedIntegers;
+		EXPECT_EQ(loadedBytes, bytes);
+		EXPECT_EQ(loadedIntegers, integers);
+	}
+};
+
+TEST_F(CSaveFileTest, compressedRoundTrip)
+{
+	auto path = directory / "full.vsgm1";
+	makeSave(path)->writeToDisk();
+
+	EXPECT_TRUE(boost::filesystem::exists(path));
+
+	// only the final file remains, temporary file is renamed to it
+	for(const auto & entry : boost::filesystem::directory_iterator(directory))
+		EXPECT_EQ(entry.path(), path);
+	EXPECT_LT(boost::filesystem::file_size(path), bytes.size());
+	EXPECT_EQ(CLoadFile::getKeyframeName(path), "");
+
+	CLoadFile load(path);
+	checkContent(load);
+}
+
+TEST_F(CSaveFileTest, truncatedSave)
+{
+	auto path = directory / "full.vsgm1";
+	makeSave(path)->writeToDisk();
+	boost::filesystem::resize_file(path, boost::filesystem::file_size(path) / 2);
+
+	CLoadFile load(path);
+	checkHeader(load);
+
+	std::vector<uint8_t> loadedBytes;
+	std::vector<int32_t> loadedIntegers;
+	EXPECT_THROW(load >> loadedBytes >> loadedIntegers, std::runtime_error);
+}
+
+TEST_F(CSaveFileTest, openNextFile)
+{
+	auto first = directory / "first.vsgm1";
+	auto second = directory / "second.vsgm1";
+	makeSave(first)->writeToDisk();
+	header = "Another header";
+	makeSave(second)->writeToDisk();
+
+	CLoadFile load(first);
+	load.openNextFile(second, ESerializationVersion::CURRENT);
+	checkContent(load);
+}
+
+TEST_F(CSaveFileTest, headerOnlyRead)
+{
+	auto path = directory / "full.vsgm1";
+	makeSave(path)->writeToDisk();
+
+	CLoadFile load(path);
+	checkHeader(load);
+}
+
+TEST_F(CSaveFileTest, deltaRoundTrip)
+{
+	auto keyframe = makeSave(directory / "Keyframe.vsgk");
+	keyframe->writeToDisk();
+
+	bytes[1000] = 255;
+	integers.push_back(42);
+	auto path = directory / "delta.vsgm1";
+	makeSave(path)->writeDeltaToDisk(path, *keyframe);
+
+	EXPECT_EQ(CLoadFile::getKeyframeName(path), "Keyframe.vsgk");
+
+	CLoadFile load(path);
+	checkContent(load);
+}
+
+TEST_F(CSaveFileTest, deltaHeaderOnlyRead)
+{
+	auto keyframePath = directory / "Keyframe.vsgk";
+	auto keyframe = makeSave(keyframePath);
+	keyframe->writeToDisk();
+
+	auto path = directory / "delta.vsgm1";
+	makeSave(path)->writeDeltaToDisk(path, *keyframe);
+
+	// header of delta save is stored separately, so keyframe must not be read unless data past header is requested
+	std::ofstream(keyframePath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc) << "corrupted";
+
+	CLoadFile load(path);
+	checkHeader(load);
+
+	std::vector<uint8_t> loadedBytes;
+	EXPECT_THROW(load >> loadedBytes, std::runtime_error);
+}
+
+TEST_F(CSaveFileTest, deltaMissingKeyframe)
+{
+	auto keyframePath = directory / "Keyframe.vsgk";
+	auto keyframe = makeSave(keyframePath);
+	keyframe->writeToDisk();
+
+	auto path = directory / "delta.vsgm1";
+	makeSave(path)->writeDeltaToDisk(path, *keyframe);
+	boost::filesystem::remove(keyframePath);
+
+	// header remains readable, so save can still be listed
+	CLoadFile load(path);
+	checkHeader(load);
+
+	std::vector<uint8_t> loadedBytes;
+	try
+	{
+		load >> loadedBytes;
+		FAIL() << "Reading past header of delta save without keyframe must fail";
+	}
+	catch(const MissingKeyframeException & e)
+	{
+		EXPECT_EQ(e.keyframeName, "Keyframe.vsgk");
+	}
+}
+
+}